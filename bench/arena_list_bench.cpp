@@ -0,0 +1,79 @@
+#include <benchmark/benchmark.h>
+
+#include "list/arena_list.h"
+#include "list/list.h"
+
+#include <random>
+
+namespace
+{
+
+// Random inserts and erases in the middle, as a long-lived list sees them,
+// which scatters neighbouring elements across the arena or the heap.
+template <class ListType>
+ListType make_churned_list(int size)
+{
+    std::mt19937 generator(size);
+    ListType l;
+
+    for (int i = 0; i < size; ++i)
+        l.push_back(i);
+
+    auto it = l.begin();
+
+    for (int round = 0; round < size * 4; ++round)
+    {
+        if (it == l.end())
+            it = l.begin();
+
+        if (generator() % 2 == 0)
+            it = l.erase(it);
+        else
+            l.insert(it, round);
+
+        for (int step = static_cast<int>(generator() % 64); step > 0 && it != l.end(); --step)
+            ++it;
+    }
+
+    return l;
+}
+
+template <class ListType>
+void iterate(benchmark::State &state, const ListType &l)
+{
+    for (auto _ : state)
+    {
+        int64_t sum = 0;
+
+        for (int value : l)
+            sum += value;
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(l.size()));
+}
+
+} // namespace
+
+static void BM_IterateChurnedList(benchmark::State &state)
+{
+    iterate(state, make_churned_list<List<int>>(static_cast<int>(state.range(0))));
+}
+
+static void BM_IterateChurnedArenaList(benchmark::State &state)
+{
+    iterate(state, make_churned_list<ArenaList<int>>(static_cast<int>(state.range(0))));
+}
+
+static void BM_IterateCompactedArenaList(benchmark::State &state)
+{
+    ArenaList<int> l = make_churned_list<ArenaList<int>>(static_cast<int>(state.range(0)));
+
+    l.compact();
+    iterate(state, l);
+}
+
+BENCHMARK(BM_IterateChurnedList)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK(BM_IterateChurnedArenaList)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK(BM_IterateCompactedArenaList)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
@@ -0,0 +1,55 @@
+#include <benchmark/benchmark.h>
+
+#include "list/compact_list.h"
+#include "list/list.h"
+
+#include <cstdint>
+
+template <class ListType>
+static void BM_IterateSmallElements(benchmark::State &state)
+{
+    const auto size = static_cast<uint32_t>(state.range(0));
+    ListType l;
+
+    for (uint32_t i = 0; i < size; ++i)
+        l.push_back(i);
+
+    for (auto _ : state)
+    {
+        uint64_t sum = 0;
+
+        for (uint32_t value : l)
+            sum += value;
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template <class ListType>
+static void BM_BuildAndDestroySmallElements(benchmark::State &state)
+{
+    const auto size = static_cast<uint32_t>(state.range(0));
+
+    for (auto _ : state)
+    {
+        ListType l;
+
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            l.push_back(i);
+            l.push_front(i);
+        }
+
+        benchmark::DoNotOptimize(l.front());
+    }
+
+    state.SetItemsProcessed(state.iterations() * size * 2);
+}
+
+BENCHMARK_TEMPLATE(BM_IterateSmallElements, List<uint32_t>)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(BM_IterateSmallElements, CompactList<uint32_t>)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+
+BENCHMARK_TEMPLATE(BM_BuildAndDestroySmallElements, List<uint32_t>)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(BM_BuildAndDestroySmallElements, CompactList<uint32_t>)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
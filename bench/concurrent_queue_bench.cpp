@@ -0,0 +1,69 @@
+#include <benchmark/benchmark.h>
+
+#include "concurrent/concurrent_queue.h"
+#include "list/list.h"
+
+#include <mutex>
+#include <optional>
+
+namespace
+{
+
+class LockedListQueue
+{
+public:
+    void push_back(int value)
+    {
+        std::lock_guard lock(mutex_);
+        list_.push_back(value);
+    }
+
+    std::optional<int> try_pop_front()
+    {
+        std::lock_guard lock(mutex_);
+
+        if (list_.empty())
+            return std::nullopt;
+
+        int value = list_.front();
+        list_.pop_front();
+
+        return value;
+    }
+
+private:
+    std::mutex mutex_;
+    List<int> list_;
+};
+
+} // namespace
+
+// Every thread alternates pushes and pops on one shared queue, so producers
+// and consumers contend on both ends at once.
+template <class QueueType>
+static void BM_ConcurrentPushPop(benchmark::State &state)
+{
+    static QueueType *queue = nullptr;
+
+    if (state.thread_index() == 0)
+        queue = new QueueType;
+
+    for (auto _ : state)
+    {
+        queue->push_back(state.thread_index());
+        benchmark::DoNotOptimize(queue->try_pop_front());
+    }
+
+    state.SetItemsProcessed(state.iterations() * 2);
+
+    if (state.thread_index() == 0)
+    {
+        while (queue->try_pop_front())
+            ;
+
+        delete queue;
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_ConcurrentPushPop, ConcurrentQueue<int>)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ConcurrentPushPop, LockedListQueue)->ThreadRange(1, 8)->UseRealTime();
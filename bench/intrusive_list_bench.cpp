@@ -0,0 +1,101 @@
+#include <benchmark/benchmark.h>
+
+#include "list/intrusive_list.h"
+#include "list/list.h"
+
+#include <vector>
+
+namespace
+{
+
+struct Object
+{
+    int64_t key_ = 0;
+    int64_t payload_[6] = {};
+    IntrusiveListHook hook_;
+};
+
+using ObjectList = IntrusiveList<Object, &Object::hook_>;
+
+} // namespace
+
+static void BM_IterateIntrusive(benchmark::State &state)
+{
+    std::vector<Object> arena(static_cast<size_t>(state.range(0)));
+    ObjectList l;
+
+    for (Object &object : arena)
+        l.push_back(object);
+
+    for (auto _ : state)
+    {
+        int64_t sum = 0;
+
+        for (const Object &object : l)
+            sum += object.key_;
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_IteratePointerList(benchmark::State &state)
+{
+    std::vector<Object> arena(static_cast<size_t>(state.range(0)));
+    List<Object *> l;
+
+    for (Object &object : arena)
+        l.push_back(&object);
+
+    for (auto _ : state)
+    {
+        int64_t sum = 0;
+
+        for (const Object *object : l)
+            sum += object->key_;
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_LinkUnlinkIntrusive(benchmark::State &state)
+{
+    std::vector<Object> arena(static_cast<size_t>(state.range(0)));
+    ObjectList l;
+
+    for (auto _ : state)
+    {
+        for (Object &object : arena)
+            l.push_back(object);
+
+        while (!l.empty())
+            l.pop_front();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_LinkUnlinkPointerList(benchmark::State &state)
+{
+    std::vector<Object> arena(static_cast<size_t>(state.range(0)));
+    List<Object *> l;
+
+    for (auto _ : state)
+    {
+        for (Object &object : arena)
+            l.push_back(&object);
+
+        while (!l.empty())
+            l.pop_front();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_IterateIntrusive)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+BENCHMARK(BM_IteratePointerList)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+BENCHMARK(BM_LinkUnlinkIntrusive)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+BENCHMARK(BM_LinkUnlinkPointerList)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
@@ -0,0 +1,213 @@
+#include <benchmark/benchmark.h>
+
+#include "list/list.h"
+#include "list/pool_allocator.h"
+
+#include <random>
+#include <string>
+
+template <class ListType>
+static void BM_PushBackPopFront(benchmark::State &state)
+{
+    const auto size = static_cast<int>(state.range(0));
+
+    for (auto _ : state)
+    {
+        ListType l;
+
+        for (int i = 0; i < size; ++i)
+            l.push_back(i);
+
+        while (!l.empty())
+            l.pop_front();
+
+        benchmark::DoNotOptimize(l);
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template <class ListType>
+static void BM_QueueChurn(benchmark::State &state)
+{
+    const auto size = static_cast<int>(state.range(0));
+    ListType l;
+
+    for (int i = 0; i < size; ++i)
+        l.push_back(i);
+
+    for (auto _ : state)
+    {
+        l.push_back(l.front());
+        l.pop_front();
+        benchmark::DoNotOptimize(l.back());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <class ListType>
+static void BM_CopyConstruct(benchmark::State &state)
+{
+    const auto size = static_cast<int>(state.range(0));
+    ListType source;
+
+    for (int i = 0; i < size; ++i)
+        source.push_back(i);
+
+    for (auto _ : state)
+    {
+        ListType copy(source);
+        benchmark::DoNotOptimize(copy);
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template <class ListType>
+static void BM_SortNearlySorted(benchmark::State &state)
+{
+    const auto size = static_cast<int>(state.range(0));
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        ListType l;
+
+        for (int i = 0; i < size; ++i)
+            l.push_back(i % 64 == 0 ? size - i : i);
+
+        state.ResumeTiming();
+
+        l.sort();
+        benchmark::DoNotOptimize(l.front());
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+static void BM_ParallelSort(benchmark::State &state)
+{
+    const auto size = static_cast<int>(state.range(0));
+    const auto threads = static_cast<size_t>(state.range(1));
+    std::mt19937 generator(size);
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        List<int> l;
+
+        for (int i = 0; i < size; ++i)
+            l.push_back(static_cast<int>(generator()));
+
+        state.ResumeTiming();
+
+        l.parallel_sort(threads);
+        benchmark::DoNotOptimize(l.front());
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+static List<std::string> make_string_list(int size)
+{
+    std::mt19937 generator(size);
+    List<std::string> l;
+
+    for (int i = 0; i < size; ++i)
+        l.push_back("key-" + std::to_string(generator()));
+
+    return l;
+}
+
+static size_t hash_key(const std::string &value)
+{
+    return std::hash<std::string>()(value);
+}
+
+static void BM_SortByHashComparator(benchmark::State &state)
+{
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        List<std::string> l = make_string_list(static_cast<int>(state.range(0)));
+        state.ResumeTiming();
+
+        l.sort([](const std::string &lhs, const std::string &rhs) { return hash_key(lhs) < hash_key(rhs); });
+        benchmark::DoNotOptimize(l.front());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_SortByHashKey(benchmark::State &state)
+{
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        List<std::string> l = make_string_list(static_cast<int>(state.range(0)));
+        state.ResumeTiming();
+
+        l.sort_by_key(hash_key);
+        benchmark::DoNotOptimize(l.front());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Type, class CmpFunc>
+static void BM_SortArithmetic(benchmark::State &state)
+{
+    const auto size = static_cast<int>(state.range(0));
+    std::mt19937_64 generator(size);
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        List<Type> l;
+
+        for (int i = 0; i < size; ++i)
+            l.push_back(static_cast<Type>(generator() >> 11));
+
+        state.ResumeTiming();
+
+        l.sort(CmpFunc());
+        benchmark::DoNotOptimize(l.front());
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template <typename Type>
+struct MergeLess
+{
+    bool operator()(const Type &lhs, const Type &rhs) const
+    {
+        return lhs < rhs;
+    }
+};
+
+BENCHMARK_TEMPLATE(BM_PushBackPopFront, List<int>)->Range(1 << 6, 1 << 18);
+BENCHMARK_TEMPLATE(BM_PushBackPopFront, List<int, PoolAllocator<int>>)->Range(1 << 6, 1 << 18);
+
+BENCHMARK_TEMPLATE(BM_QueueChurn, List<int>)->Range(1 << 6, 1 << 18);
+BENCHMARK_TEMPLATE(BM_QueueChurn, List<int, PoolAllocator<int>>)->Range(1 << 6, 1 << 18);
+
+BENCHMARK_TEMPLATE(BM_CopyConstruct, List<int>)->Range(1 << 6, 1 << 18);
+BENCHMARK_TEMPLATE(BM_CopyConstruct, List<int, PoolAllocator<int>>)->Range(1 << 6, 1 << 18);
+
+BENCHMARK_TEMPLATE(BM_SortNearlySorted, List<int>)->Range(1 << 10, 1 << 20);
+
+BENCHMARK(BM_ParallelSort)
+    ->ArgsProduct({{1 << 18, 1 << 21}, {1, 2, 4, 8, 16, 32}})
+    ->ArgNames({"size", "threads"})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK(BM_SortByHashComparator)->Range(1 << 10, 1 << 20)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_SortByHashKey)->Range(1 << 10, 1 << 20)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(BM_SortArithmetic, uint64_t, MergeLess<uint64_t>)->RangeMultiplier(4)->Range(1 << 4, 1 << 20);
+BENCHMARK_TEMPLATE(BM_SortArithmetic, uint64_t, std::less<uint64_t>)->RangeMultiplier(4)->Range(1 << 4, 1 << 20);
+BENCHMARK_TEMPLATE(BM_SortArithmetic, double, MergeLess<double>)->RangeMultiplier(4)->Range(1 << 4, 1 << 20);
+BENCHMARK_TEMPLATE(BM_SortArithmetic, double, std::less<double>)->RangeMultiplier(4)->Range(1 << 4, 1 << 20);
@@ -0,0 +1,392 @@
+#include <benchmark/benchmark.h>
+
+#include "list/list.h"
+
+#include <array>
+#include <iterator>
+#include <list>
+#include <random>
+#include <string>
+
+namespace
+{
+
+struct LargePod
+{
+    std::array<int64_t, 16> fields;
+
+    bool operator<(const LargePod &other) const noexcept
+    {
+        return fields[0] < other.fields[0];
+    }
+};
+
+template <typename Type>
+Type make_value(int seed);
+
+template <>
+int make_value<int>(int seed)
+{
+    return seed;
+}
+
+template <>
+std::string make_value<std::string>(int seed)
+{
+    // Long enough to defeat the small string optimisation.
+    return "benchmark-value-" + std::to_string(seed) + "-with-heap-storage";
+}
+
+template <>
+LargePod make_value<LargePod>(int seed)
+{
+    LargePod value{};
+    value.fields.fill(seed);
+    return value;
+}
+
+template <class ListType>
+ListType make_list(int size, bool shuffled = false)
+{
+    using Type = typename ListType::value_type;
+
+    std::mt19937 generator(size);
+    ListType l;
+
+    for (int i = 0; i < size; ++i)
+        l.push_back(make_value<Type>(shuffled ? static_cast<int>(generator() >> 1) : i));
+
+    return l;
+}
+
+} // namespace
+
+template <class ListType>
+static void BM_PushPopBack(benchmark::State &state)
+{
+    using Type = typename ListType::value_type;
+    const auto size = static_cast<int>(state.range(0));
+    const Type value = make_value<Type>(size);
+
+    for (auto _ : state)
+    {
+        ListType l;
+
+        for (int i = 0; i < size; ++i)
+            l.push_back(value);
+
+        while (!l.empty())
+            l.pop_back();
+
+        benchmark::DoNotOptimize(l);
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template <class ListType>
+static void BM_PushPopFront(benchmark::State &state)
+{
+    using Type = typename ListType::value_type;
+    const auto size = static_cast<int>(state.range(0));
+    const Type value = make_value<Type>(size);
+
+    for (auto _ : state)
+    {
+        ListType l;
+
+        for (int i = 0; i < size; ++i)
+            l.push_front(value);
+
+        while (!l.empty())
+            l.pop_front();
+
+        benchmark::DoNotOptimize(l);
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template <class ListType>
+static void BM_Iterate(benchmark::State &state)
+{
+    const auto size = static_cast<int>(state.range(0));
+    const ListType l = make_list<ListType>(size);
+
+    for (auto _ : state)
+    {
+        for (const auto &value : l)
+            benchmark::DoNotOptimize(&value);
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+// Inserts and erases one element in the middle of the list, the position is
+// found once so only the node operations are measured.
+template <class ListType>
+static void BM_InsertEraseMiddle(benchmark::State &state)
+{
+    using Type = typename ListType::value_type;
+    const auto size = static_cast<int>(state.range(0));
+    const Type value = make_value<Type>(size);
+
+    ListType l = make_list<ListType>(size);
+    auto middle = std::next(l.begin(), size / 2);
+
+    for (auto _ : state)
+    {
+        auto inserted = l.insert(middle, value);
+        benchmark::DoNotOptimize(&*inserted);
+        l.erase(inserted);
+    }
+
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+
+template <class ListType>
+static void BM_SpliceRange(benchmark::State &state)
+{
+    const auto size = static_cast<int>(state.range(0));
+
+    ListType source = make_list<ListType>(size);
+    ListType destination = make_list<ListType>(size);
+
+    for (auto _ : state)
+    {
+        auto first = std::next(source.begin(), size / 4);
+        auto last = std::next(first, size / 2);
+
+        destination.splice(destination.begin(), source, first, last);
+        source.splice(source.end(), destination, destination.begin(), std::next(destination.begin(), size / 2));
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template <class ListType>
+static void BM_Sort(benchmark::State &state)
+{
+    const auto size = static_cast<int>(state.range(0));
+    const ListType source = make_list<ListType>(size, true);
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        ListType l(source);
+        state.ResumeTiming();
+
+        l.sort();
+        benchmark::DoNotOptimize(l.front());
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template <class ListType>
+static void BM_Merge(benchmark::State &state)
+{
+    const auto size = static_cast<int>(state.range(0));
+    ListType lhs_source = make_list<ListType>(size, true);
+    ListType rhs_source = make_list<ListType>(size, true);
+
+    lhs_source.sort();
+    rhs_source.sort();
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        ListType lhs(lhs_source);
+        ListType rhs(rhs_source);
+        state.ResumeTiming();
+
+        lhs.merge(rhs);
+        benchmark::DoNotOptimize(lhs.front());
+    }
+
+    state.SetItemsProcessed(state.iterations() * size * 2);
+}
+
+template <class ListType>
+static void BM_Reverse(benchmark::State &state)
+{
+    const auto size = static_cast<int>(state.range(0));
+    ListType l = make_list<ListType>(size);
+
+    for (auto _ : state)
+    {
+        l.reverse();
+        benchmark::DoNotOptimize(l.front());
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template <class ListType>
+static void BM_Copy(benchmark::State &state)
+{
+    const auto size = static_cast<int>(state.range(0));
+    const ListType source = make_list<ListType>(size);
+
+    for (auto _ : state)
+    {
+        ListType copy(source);
+        benchmark::DoNotOptimize(copy);
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+// Reassigns a list of the same length every iteration.
+template <class ListType>
+static void BM_CopyAssign(benchmark::State &state)
+{
+    const auto size = static_cast<int>(state.range(0));
+    const ListType source = make_list<ListType>(size);
+    ListType destination = make_list<ListType>(size, true);
+
+    for (auto _ : state)
+    {
+        destination = source;
+        benchmark::DoNotOptimize(destination);
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template <class ListType>
+static void BM_Move(benchmark::State &state)
+{
+    const auto size = static_cast<int>(state.range(0));
+    ListType l = make_list<ListType>(size);
+
+    for (auto _ : state)
+    {
+        ListType moved(std::move(l));
+        l = std::move(moved);
+        benchmark::DoNotOptimize(l);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Drops every second element. The list is rebuilt outside of the timed
+// region.
+template <class ListType>
+static void BM_RemoveIf(benchmark::State &state)
+{
+    using Type = typename ListType::value_type;
+    const auto size = static_cast<int>(state.range(0));
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        ListType l = make_list<ListType>(size);
+        state.ResumeTiming();
+
+        size_t index = 0;
+        l.remove_if([&index](const Type &) { return index++ % 2 == 0; });
+        benchmark::DoNotOptimize(l.size());
+
+        state.PauseTiming();
+        l.clear();
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+// The same cleanup pass written as a loop of single erase calls.
+template <class ListType>
+static void BM_RemoveWithEraseLoop(benchmark::State &state)
+{
+    const auto size = static_cast<int>(state.range(0));
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        ListType l = make_list<ListType>(size);
+        state.ResumeTiming();
+
+        size_t index = 0;
+
+        for (auto it = l.begin(); it != l.end();)
+            it = index++ % 2 == 0 ? l.erase(it) : std::next(it);
+
+        benchmark::DoNotOptimize(l.size());
+
+        state.PauseTiming();
+        l.clear();
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+// Moves the front element to the back of another list, the way a scheduler
+// re-queues a task entry.
+template <class ListType>
+static void BM_RequeueWithErase(benchmark::State &state)
+{
+    const auto size = static_cast<int>(state.range(0));
+
+    ListType pending = make_list<ListType>(size);
+    ListType done;
+
+    for (auto _ : state)
+    {
+        done.push_back(std::move(pending.front()));
+        pending.erase(pending.begin());
+
+        if (pending.empty())
+            pending.swap(done);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <class ListType>
+static void BM_RequeueWithNodeHandle(benchmark::State &state)
+{
+    const auto size = static_cast<int>(state.range(0));
+
+    ListType pending = make_list<ListType>(size);
+    ListType done;
+
+    for (auto _ : state)
+    {
+        done.push_back(pending.extract(pending.cbegin()));
+
+        if (pending.empty())
+            pending.swap(done);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+#define LIST_BENCHMARK_FOR_TYPE(benchmark_name, Type)                                         \
+    BENCHMARK_TEMPLATE(benchmark_name, List<Type>)->RangeMultiplier(16)->Range(1 << 4, 1 << 16); \
+    BENCHMARK_TEMPLATE(benchmark_name, std::list<Type>)->RangeMultiplier(16)->Range(1 << 4, 1 << 16)
+
+#define LIST_BENCHMARK(benchmark_name)                   \
+    LIST_BENCHMARK_FOR_TYPE(benchmark_name, int);         \
+    LIST_BENCHMARK_FOR_TYPE(benchmark_name, std::string); \
+    LIST_BENCHMARK_FOR_TYPE(benchmark_name, LargePod)
+
+LIST_BENCHMARK(BM_PushPopBack);
+LIST_BENCHMARK(BM_PushPopFront);
+LIST_BENCHMARK(BM_Iterate);
+LIST_BENCHMARK(BM_InsertEraseMiddle);
+LIST_BENCHMARK(BM_SpliceRange);
+LIST_BENCHMARK(BM_Sort);
+LIST_BENCHMARK(BM_Merge);
+LIST_BENCHMARK(BM_Reverse);
+LIST_BENCHMARK(BM_Copy);
+LIST_BENCHMARK(BM_CopyAssign);
+LIST_BENCHMARK(BM_Move);
+LIST_BENCHMARK(BM_RemoveIf);
+LIST_BENCHMARK_FOR_TYPE(BM_RemoveWithEraseLoop, int);
+BENCHMARK_TEMPLATE(BM_RequeueWithErase, List<int>)->Arg(1 << 10);
+BENCHMARK_TEMPLATE(BM_RequeueWithErase, List<std::string>)->Arg(1 << 10);
+BENCHMARK_TEMPLATE(BM_RequeueWithNodeHandle, List<int>)->Arg(1 << 10);
+BENCHMARK_TEMPLATE(BM_RequeueWithNodeHandle, List<std::string>)->Arg(1 << 10);
@@ -0,0 +1,81 @@
+#include <benchmark/benchmark.h>
+
+#include "persistent/list_serialization.h"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace
+{
+
+std::string bench_path(const char *name)
+{
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+List<int64_t> make_list(int64_t size)
+{
+    List<int64_t> l;
+
+    for (int64_t i = 0; i < size; ++i)
+        l.push_back(i);
+
+    return l;
+}
+
+} // namespace
+
+// Checkpointing as it's done today: one formatted element per line.
+static void BM_CheckpointWithIostream(benchmark::State &state)
+{
+    const std::string path = bench_path("list_checkpoint_iostream");
+    List<int64_t> l = make_list(state.range(0));
+
+    for (auto _ : state)
+    {
+        {
+            std::ofstream out(path);
+
+            for (int64_t value : l)
+                out << value << '\n';
+        }
+
+        std::ifstream in(path);
+        List<int64_t> restored;
+        int64_t value;
+
+        while (in >> value)
+            restored.push_back(value);
+
+        benchmark::DoNotOptimize(restored.size());
+    }
+
+    std::filesystem::remove(path);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_CheckpointWithSerialize(benchmark::State &state)
+{
+    const std::string path = bench_path("list_checkpoint_serialize");
+    List<int64_t> l = make_list(state.range(0));
+
+    for (auto _ : state)
+    {
+        {
+            FileSink sink(path);
+            serialize(l, sink);
+        }
+
+        FileSource source(path);
+        List<int64_t> restored = deserialize<int64_t>(source);
+
+        benchmark::DoNotOptimize(restored.size());
+    }
+
+    std::filesystem::remove(path);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_CheckpointWithIostream)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CheckpointWithSerialize)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
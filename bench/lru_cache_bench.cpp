@@ -0,0 +1,99 @@
+#include <benchmark/benchmark.h>
+
+#include "list/list.h"
+#include "list/lru_cache.h"
+
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+std::vector<int> random_keys(int key_range)
+{
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> distribution(0, key_range - 1);
+    std::vector<int> keys(4096);
+
+    for (int &key : keys)
+        key = distribution(generator);
+
+    return keys;
+}
+
+// The usual recipe: a list for the order and a map from keys to iterators,
+// two allocations per entry.
+class MapListCache
+{
+public:
+    explicit MapListCache(size_t capacity) : capacity_(capacity)
+    {
+    }
+
+    void put(int key, int value)
+    {
+        auto found = index_.find(key);
+
+        if (found != index_.end())
+        {
+            (*found->second).second = value;
+            entries_.splice(entries_.cbegin(), entries_, found->second);
+            return;
+        }
+
+        entries_.push_front({key, value});
+        index_.emplace(key, entries_.begin());
+
+        if (entries_.size() > capacity_)
+        {
+            index_.erase(entries_.back().first);
+            entries_.pop_back();
+        }
+    }
+
+private:
+    size_t capacity_;
+    List<std::pair<int, int>> entries_;
+    std::unordered_map<int, List<std::pair<int, int>>::iterator> index_;
+};
+
+}
+
+static void BM_LruCachePut(benchmark::State &state)
+{
+    int capacity = static_cast<int>(state.range(0));
+    std::vector<int> keys = random_keys(capacity * 2);
+    LruCache<int, int> cache(capacity);
+
+    for (auto _ : state)
+    {
+        for (int key : keys)
+            cache.put(key, key);
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+static void BM_MapListCachePut(benchmark::State &state)
+{
+    int capacity = static_cast<int>(state.range(0));
+    std::vector<int> keys = random_keys(capacity * 2);
+    MapListCache cache(capacity);
+
+    for (auto _ : state)
+    {
+        for (int key : keys)
+            cache.put(key, key);
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+BENCHMARK(BM_LruCachePut)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK(BM_MapListCachePut)->Arg(1 << 10)->Arg(1 << 16);
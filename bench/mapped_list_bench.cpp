@@ -0,0 +1,77 @@
+#include <benchmark/benchmark.h>
+
+#include "list/list.h"
+#include "persistent/mapped_list.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+
+std::string bench_path(const char *name, int64_t size)
+{
+    return (std::filesystem::temp_directory_path() / (std::string(name) + std::to_string(size))).string();
+}
+
+} // namespace
+
+// Startup cost when the list already lives in a mapped file: open it and
+// walk it once.
+static void BM_StartupFromMappedFile(benchmark::State &state)
+{
+    const std::string path = bench_path("mapped_list_bench_", state.range(0));
+    std::filesystem::remove(path);
+
+    {
+        MappedList<int64_t> l(path);
+
+        for (int64_t i = 0; i < state.range(0); ++i)
+            l.push_back(i);
+    }
+
+    for (auto _ : state)
+    {
+        MappedList<int64_t> l(path);
+        benchmark::DoNotOptimize(std::accumulate(l.begin(), l.end(), int64_t(0)));
+    }
+
+    std::filesystem::remove(path);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Startup cost of the current approach: read the values from a file and
+// rebuild a List, then walk it once.
+static void BM_StartupByRebuildingList(benchmark::State &state)
+{
+    const std::string path = bench_path("list_values_bench_", state.range(0));
+
+    {
+        std::vector<int64_t> values(static_cast<size_t>(state.range(0)));
+        std::iota(values.begin(), values.end(), 0);
+
+        std::ofstream out(path, std::ios::binary);
+        out.write(reinterpret_cast<const char *>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(int64_t)));
+    }
+
+    for (auto _ : state)
+    {
+        std::ifstream in(path, std::ios::binary);
+        List<int64_t> l;
+        int64_t value;
+
+        while (in.read(reinterpret_cast<char *>(&value), sizeof(value)))
+            l.push_back(value);
+
+        benchmark::DoNotOptimize(std::accumulate(l.begin(), l.end(), int64_t(0)));
+    }
+
+    std::filesystem::remove(path);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_StartupFromMappedFile)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StartupByRebuildingList)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,83 @@
+#include <benchmark/benchmark.h>
+
+#include "list/list.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <thread>
+
+namespace
+{
+
+List<double> make_list(int64_t size)
+{
+    List<double> l;
+
+    for (int64_t i = 0; i < size; ++i)
+        l.push_back(static_cast<double>(i % 1000) / 7.0);
+
+    return l;
+}
+
+// A few dependent floating point operations per element, roughly what an
+// aggregation over a parsed record costs.
+inline void transform_value(double &value)
+{
+    value = std::sqrt(value * value + 1.0) * 0.5;
+}
+
+} // namespace
+
+static void BM_ForEachSerial(benchmark::State &state)
+{
+    List<double> l = make_list(state.range(0));
+
+    for (auto _ : state)
+    {
+        std::for_each(l.begin(), l.end(), transform_value);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_ForEachParallel(benchmark::State &state)
+{
+    List<double> l = make_list(state.range(0));
+
+    for (auto _ : state)
+    {
+        l.parallel_for_each(transform_value);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["threads"] = std::thread::hardware_concurrency();
+}
+
+static void BM_ReduceSerial(benchmark::State &state)
+{
+    List<double> l = make_list(state.range(0));
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(std::accumulate(l.begin(), l.end(), 0.0));
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_ReduceParallel(benchmark::State &state)
+{
+    List<double> l = make_list(state.range(0));
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(l.parallel_reduce(0.0, std::plus<>()));
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["threads"] = std::thread::hardware_concurrency();
+}
+
+BENCHMARK(BM_ForEachSerial)->RangeMultiplier(8)->Range(1 << 14, 1 << 20);
+BENCHMARK(BM_ForEachParallel)->RangeMultiplier(8)->Range(1 << 14, 1 << 20);
+BENCHMARK(BM_ReduceSerial)->RangeMultiplier(8)->Range(1 << 14, 1 << 20);
+BENCHMARK(BM_ReduceParallel)->RangeMultiplier(8)->Range(1 << 14, 1 << 20);
@@ -0,0 +1,161 @@
+#include <benchmark/benchmark.h>
+
+#include "list/list.h"
+
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+List<int> make_list(int size)
+{
+    List<int> l;
+
+    for (int i = 0; i < size; ++i)
+        l.push_back(i);
+
+    return l;
+}
+
+std::vector<size_t> random_positions(size_t size)
+{
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<size_t> distribution(0, size - 1);
+    std::vector<size_t> positions(1024);
+
+    for (size_t &position : positions)
+        position = distribution(generator);
+
+    return positions;
+}
+
+} // namespace
+
+static void BM_RandomReadWithNext(benchmark::State &state)
+{
+    const List<int> l = make_list(static_cast<int>(state.range(0)));
+    const std::vector<size_t> positions = random_positions(l.size());
+    size_t i = 0;
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(*std::next(l.begin(), positions[i++ % positions.size()]));
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_RandomReadWithNth(benchmark::State &state)
+{
+    const List<int> l = make_list(static_cast<int>(state.range(0)));
+    const std::vector<size_t> positions = random_positions(l.size());
+    size_t i = 0;
+
+    benchmark::DoNotOptimize(*l.nth(0));
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(*l.nth(positions[i++ % positions.size()]));
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_IndexOf(benchmark::State &state)
+{
+    const List<int> l = make_list(static_cast<int>(state.range(0)));
+    const std::vector<size_t> positions = random_positions(l.size());
+    std::vector<List<int>::const_iterator> iterators;
+    size_t i = 0;
+
+    for (size_t position : positions)
+        iterators.push_back(l.nth(position));
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(l.index_of(iterators[i++ % iterators.size()]));
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_RandomReadWithNext)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+BENCHMARK(BM_RandomReadWithNth)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+BENCHMARK(BM_IndexOf)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+
+namespace
+{
+
+// Event timestamps that mostly arrive in order, a few slightly late.
+std::vector<int> nearly_ordered_events(int count)
+{
+    std::mt19937 generator(count);
+    std::vector<int> events(static_cast<size_t>(count));
+
+    for (int i = 0; i < count; ++i)
+        events[static_cast<size_t>(i)] = i * 4 - static_cast<int>(generator() % 64);
+
+    return events;
+}
+
+} // namespace
+
+static void BM_SortedInsertWithFindIf(benchmark::State &state)
+{
+    const std::vector<int> events = nearly_ordered_events(static_cast<int>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        List<int> l;
+
+        for (int event : events)
+            l.insert(std::find_if(l.begin(), l.end(), [event](int value) { return event < value; }), event);
+
+        benchmark::DoNotOptimize(l.size());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_SortedInsertWithFinger(benchmark::State &state)
+{
+    const std::vector<int> events = nearly_ordered_events(static_cast<int>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        List<int> l;
+
+        for (int event : events)
+            l.insert_sorted(event);
+
+        benchmark::DoNotOptimize(l.size());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_LowerBoundLinear(benchmark::State &state)
+{
+    const List<int> l = make_list(static_cast<int>(state.range(0)));
+    const std::vector<size_t> positions = random_positions(l.size());
+    size_t i = 0;
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(std::lower_bound(l.begin(), l.end(), static_cast<int>(positions[i++ % positions.size()])));
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_LowerBoundWithSkipIndex(benchmark::State &state)
+{
+    const List<int> l = make_list(static_cast<int>(state.range(0)));
+    const std::vector<size_t> positions = random_positions(l.size());
+    size_t i = 0;
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(l.lower_bound(static_cast<int>(positions[i++ % positions.size()])));
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_SortedInsertWithFindIf)->RangeMultiplier(4)->Range(1 << 10, 1 << 14);
+BENCHMARK(BM_SortedInsertWithFinger)->RangeMultiplier(4)->Range(1 << 10, 1 << 18);
+BENCHMARK(BM_LowerBoundLinear)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+BENCHMARK(BM_LowerBoundWithSkipIndex)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
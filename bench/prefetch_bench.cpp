@@ -0,0 +1,101 @@
+#include <benchmark/benchmark.h>
+
+#include "list/list.h"
+#include "list/prefetch.h"
+
+#include <numeric>
+#include <random>
+
+namespace
+{
+
+// Sorting random values relinks the nodes, so consecutive elements end up
+// scattered across the heap and every step of a walk is a cache miss.
+List<int64_t> make_shuffled_list(int size)
+{
+    std::mt19937_64 generator(size);
+    List<int64_t> l;
+
+    for (int i = 0; i < size; ++i)
+        l.push_back(static_cast<int64_t>(generator() >> 1));
+
+    l.sort([](int64_t lhs, int64_t rhs) { return lhs < rhs; });
+
+    return l;
+}
+
+} // namespace
+
+static void BM_AccumulateShuffled(benchmark::State &state)
+{
+    const List<int64_t> l = make_shuffled_list(static_cast<int>(state.range(0)));
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(std::accumulate(l.begin(), l.end(), int64_t(0)));
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_AccumulateShuffledInterleaved(benchmark::State &state)
+{
+    const List<int64_t> l = make_shuffled_list(static_cast<int>(state.range(0)));
+    const auto lanes = split_into_lanes(l, static_cast<size_t>(state.range(1)));
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(accumulate_interleaved(lanes, int64_t(0)));
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_FindIfShuffledInterleaved(benchmark::State &state)
+{
+    const List<int64_t> l = make_shuffled_list(static_cast<int>(state.range(0)));
+    const auto lanes = split_into_lanes(l, static_cast<size_t>(state.range(1)));
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(find_if_interleaved(lanes, [](int64_t value) { return value < 0; }));
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_SortShuffled(benchmark::State &state)
+{
+    std::mt19937_64 generator(state.range(0));
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        List<int64_t> l = make_shuffled_list(static_cast<int>(state.range(0)));
+
+        for (int64_t &value : l)
+            value = static_cast<int64_t>(generator() >> 1);
+
+        state.ResumeTiming();
+
+        l.sort([](int64_t lhs, int64_t rhs) { return lhs < rhs; });
+        benchmark::DoNotOptimize(l.front());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_ClearShuffled(benchmark::State &state)
+{
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        List<int64_t> l = make_shuffled_list(static_cast<int>(state.range(0)));
+        state.ResumeTiming();
+
+        l.clear();
+        benchmark::DoNotOptimize(l);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_AccumulateShuffled)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK(BM_AccumulateShuffledInterleaved)->ArgsProduct({{1 << 16, 1 << 20}, {1, 2, 4, 8, 16}});
+BENCHMARK(BM_FindIfShuffledInterleaved)->ArgsProduct({{1 << 16, 1 << 20}, {1, 4, 16}});
+BENCHMARK(BM_SortShuffled)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ClearShuffled)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,37 @@
+#include <benchmark/benchmark.h>
+
+#include "list/list.h"
+#include "list/small_list.h"
+
+#include <vector>
+
+// Builds a table of many tiny lists and tears it down again, the pattern of
+// per-connection pending operations or adjacency lists.
+template <class ListType>
+static void BM_TinyListTable(benchmark::State &state)
+{
+    const auto lists = static_cast<size_t>(state.range(0));
+    const auto elements = static_cast<int>(state.range(1));
+
+    for (auto _ : state)
+    {
+        std::vector<ListType> table(lists);
+
+        for (ListType &l : table)
+            for (int i = 0; i < elements; ++i)
+                l.push_back(i);
+
+        int64_t sum = 0;
+
+        for (const ListType &l : table)
+            for (int value : l)
+                sum += value;
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(1));
+}
+
+BENCHMARK_TEMPLATE(BM_TinyListTable, List<int>)->ArgsProduct({{1 << 16}, {1, 2, 4, 8}});
+BENCHMARK_TEMPLATE(BM_TinyListTable, SmallList<int, 4>)->ArgsProduct({{1 << 16}, {1, 2, 4, 8}});
@@ -0,0 +1,54 @@
+#include <benchmark/benchmark.h>
+
+#include "list/list.h"
+#include "list/unrolled_list.h"
+
+#include <numeric>
+#include <random>
+
+template <class ListType>
+static ListType make_shuffled_list(int size)
+{
+    std::mt19937 generator(size);
+    ListType l;
+
+    for (int i = 0; i < size; ++i)
+        l.push_back(static_cast<int>(generator()));
+
+    return l;
+}
+
+template <class ListType>
+static void BM_Iterate(benchmark::State &state)
+{
+    ListType l = make_shuffled_list<ListType>(static_cast<int>(state.range(0)));
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(std::accumulate(l.begin(), l.end(), 0LL));
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <class ListType>
+static void BM_Sort(benchmark::State &state)
+{
+    const auto size = static_cast<int>(state.range(0));
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        ListType l = make_shuffled_list<ListType>(size);
+        state.ResumeTiming();
+
+        l.sort();
+        benchmark::DoNotOptimize(l.front());
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+BENCHMARK_TEMPLATE(BM_Iterate, List<int>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_Iterate, UnrolledList<int>)->Range(1 << 10, 1 << 20);
+
+BENCHMARK_TEMPLATE(BM_Sort, List<int>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_Sort, UnrolledList<int>)->Range(1 << 10, 1 << 20);
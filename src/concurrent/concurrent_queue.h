@@ -0,0 +1,236 @@
+#pragma once
+
+#include <concurrent/hazard_pointers.h>
+
+#include <atomic>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+
+// Lock-free multi-producer multi-consumer FIFO queue after Michael and Scott.
+// Like List it is a chain of single-element nodes, but the links are atomic
+// and the chain always starts with a dummy node whose value was already
+// popped. Unlinked nodes are reclaimed through HazardPointers.
+template <typename Type>
+class ConcurrentQueue
+{
+    static_assert(std::is_nothrow_move_constructible_v<Type>,
+                  "Popped values are moved out after the node is unlinked");
+
+private:
+    struct Node
+    {
+        Node() = default;
+
+        template <typename... Types>
+        explicit Node(std::in_place_t, Types &&...args)
+        {
+            ::new (storage_) Type(std::forward<Types>(args)...);
+        }
+
+        Type *value() noexcept
+        {
+            return std::launder(reinterpret_cast<Type *>(storage_));
+        }
+
+        static void destroy(void *node)
+        {
+            delete static_cast<Node *>(node);
+        }
+
+        std::atomic<Node *> next_{nullptr};
+        alignas(Type) unsigned char storage_[sizeof(Type)];
+    };
+
+    static constexpr size_t head_slot = 0;
+    static constexpr size_t next_slot = 1;
+
+public: // Special member functions
+    ConcurrentQueue() : head_(new Node), tail_(head_.load())
+    {
+    }
+
+    ConcurrentQueue(const ConcurrentQueue &) = delete;
+    ConcurrentQueue &operator=(const ConcurrentQueue &) = delete;
+
+    // Must not run concurrently with any other member function.
+    ~ConcurrentQueue()
+    {
+        Node *node = head_.load();
+        Node *next = node->next_.load();
+
+        delete node;
+
+        while (next != nullptr)
+        {
+            node = next;
+            next = node->next_.load();
+
+            std::destroy_at(node->value());
+            delete node;
+        }
+    }
+
+public: // Size-related methods
+    // Only a snapshot, other threads may change the queue right after it.
+    bool empty() const noexcept
+    {
+        Node *head = HazardPointers::protect(head_, head_slot);
+        bool result = head->next_.load() == nullptr;
+
+        HazardPointers::clear(head_slot);
+
+        return result;
+    }
+
+public: // Modifying methods
+    void push_back(const Type &value)
+    {
+        emplace_back(value);
+    }
+
+    void push_back(Type &&value)
+    {
+        emplace_back(std::move(value));
+    }
+
+    template <typename... Types>
+    void emplace_back(Types &&...args)
+    {
+        Node *node = new Node(std::in_place, std::forward<Types>(args)...);
+
+        enqueue_chain(node, node);
+    }
+
+    // Links the whole range privately first and publishes it with a single
+    // compare-and-swap, so the elements stay contiguous in the queue.
+    template <typename _InputIterator>
+    void push_range(_InputIterator first, _InputIterator last)
+    {
+        if (first == last)
+            return;
+
+        Node *chain_first = new Node(std::in_place, *first);
+        Node *chain_last = chain_first;
+
+        try
+        {
+            for (++first; first != last; ++first)
+            {
+                Node *node = new Node(std::in_place, *first);
+
+                chain_last->next_.store(node, std::memory_order_relaxed);
+                chain_last = node;
+            }
+        }
+        catch (...)
+        {
+            while (chain_first != nullptr)
+            {
+                Node *next = chain_first->next_.load(std::memory_order_relaxed);
+
+                std::destroy_at(chain_first->value());
+                delete chain_first;
+                chain_first = next;
+            }
+
+            throw;
+        }
+
+        enqueue_chain(chain_first, chain_last);
+    }
+
+    std::optional<Type> try_pop_front()
+    {
+        std::optional<Type> result;
+
+        while (true)
+        {
+            Node *head = HazardPointers::protect(head_, head_slot);
+            Node *tail = tail_.load();
+            Node *next = HazardPointers::protect(head->next_, next_slot);
+
+            if (head != head_.load())
+                continue;
+
+            if (next == nullptr)
+                break;
+
+            if (head == tail)
+            {
+                tail_.compare_exchange_weak(tail, next);
+                continue;
+            }
+
+            if (head_.compare_exchange_weak(head, next))
+            {
+                result.emplace(std::move(*next->value()));
+                std::destroy_at(next->value());
+
+                HazardPointers::clear(head_slot);
+                HazardPointers::clear(next_slot);
+                HazardPointers::retire(head, &Node::destroy);
+
+                return result;
+            }
+        }
+
+        HazardPointers::clear(head_slot);
+        HazardPointers::clear(next_slot);
+
+        return result;
+    }
+
+    // Pops up to max_count elements into out and returns how many were
+    // popped. Stops early once the queue is seen empty.
+    template <typename _OutputIterator>
+    size_t pop_batch(_OutputIterator out, size_t max_count)
+    {
+        size_t count = 0;
+
+        for (; count < max_count; ++count)
+        {
+            std::optional<Type> value = try_pop_front();
+
+            if (!value)
+                break;
+
+            *out = std::move(*value);
+            ++out;
+        }
+
+        return count;
+    }
+
+private: // Internal logic
+    void enqueue_chain(Node *first, Node *last)
+    {
+        while (true)
+        {
+            Node *tail = HazardPointers::protect(tail_, head_slot);
+            Node *next = tail->next_.load();
+
+            if (tail != tail_.load())
+                continue;
+
+            if (next != nullptr)
+            {
+                tail_.compare_exchange_weak(tail, next);
+                continue;
+            }
+
+            if (tail->next_.compare_exchange_weak(next, first))
+            {
+                tail_.compare_exchange_strong(tail, last);
+                break;
+            }
+        }
+
+        HazardPointers::clear(head_slot);
+    }
+
+private:
+    alignas(64) std::atomic<Node *> head_;
+    alignas(64) std::atomic<Node *> tail_;
+};
@@ -0,0 +1,141 @@
+#include <concurrent/hazard_pointers.h>
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+    struct Record
+    {
+        std::atomic<bool> active_{true};
+        std::atomic<void *> slots_[HazardPointers::slots_per_thread] = {};
+        Record *next_ = nullptr;
+    };
+
+    struct Retired
+    {
+        void *pointer_;
+        HazardPointers::Deleter deleter_;
+    };
+
+    struct Domain
+    {
+        ~Domain()
+        {
+            for (Retired &retired : orphans_)
+                retired.deleter_(retired.pointer_);
+
+            while (Record *record = records_.load())
+            {
+                records_.store(record->next_);
+                delete record;
+            }
+        }
+
+        std::atomic<Record *> records_{nullptr};
+        std::atomic<size_t> record_count_{0};
+
+        std::mutex orphans_mutex_;
+        std::vector<Retired> orphans_;
+    };
+
+    Domain domain;
+
+    Record *acquire_record()
+    {
+        for (Record *record = domain.records_.load(); record != nullptr; record = record->next_)
+        {
+            bool expected = false;
+
+            if (record->active_.compare_exchange_strong(expected, true))
+                return record;
+        }
+
+        Record *record = new Record;
+        record->next_ = domain.records_.load();
+
+        while (!domain.records_.compare_exchange_weak(record->next_, record))
+        {
+        }
+
+        ++domain.record_count_;
+
+        return record;
+    }
+
+    struct ThreadState
+    {
+        ThreadState() : record_(acquire_record())
+        {
+        }
+
+        ~ThreadState()
+        {
+            for (std::atomic<void *> &slot : record_->slots_)
+                slot.store(nullptr);
+
+            scan();
+
+            if (!retired_.empty())
+            {
+                std::lock_guard lock(domain.orphans_mutex_);
+                domain.orphans_.insert(domain.orphans_.end(), retired_.begin(), retired_.end());
+            }
+
+            record_->active_.store(false);
+        }
+
+        void scan()
+        {
+            {
+                std::lock_guard lock(domain.orphans_mutex_);
+                retired_.insert(retired_.end(), domain.orphans_.begin(), domain.orphans_.end());
+                domain.orphans_.clear();
+            }
+
+            std::vector<void *> hazards;
+
+            for (Record *record = domain.records_.load(); record != nullptr; record = record->next_)
+                for (std::atomic<void *> &slot : record->slots_)
+                    if (void *pointer = slot.load())
+                        hazards.push_back(pointer);
+
+            std::sort(hazards.begin(), hazards.end());
+
+            auto still_hazardous = [&hazards](const Retired &retired)
+            { return std::binary_search(hazards.begin(), hazards.end(), retired.pointer_); };
+
+            auto free_from = std::partition(retired_.begin(), retired_.end(), still_hazardous);
+
+            for (auto it = free_from; it != retired_.end(); ++it)
+                it->deleter_(it->pointer_);
+
+            retired_.erase(free_from, retired_.end());
+        }
+
+        Record *record_;
+        std::vector<Retired> retired_;
+    };
+
+    ThreadState &thread_state()
+    {
+        thread_local ThreadState state;
+        return state;
+    }
+}
+
+std::atomic<void *> *HazardPointers::slots()
+{
+    return thread_state().record_->slots_;
+}
+
+void HazardPointers::retire(void *pointer, Deleter deleter)
+{
+    ThreadState &state = thread_state();
+
+    state.retired_.push_back(Retired{pointer, deleter});
+
+    if (state.retired_.size() >= 64 + 2 * slots_per_thread * domain.record_count_.load())
+        state.scan();
+}
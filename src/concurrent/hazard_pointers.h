@@ -0,0 +1,45 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+// Process-wide hazard pointer domain. Every thread owns a small set of
+// hazard slots; a pointer published in a slot is never reclaimed, and
+// retired pointers are freed once no slot holds them anymore.
+class HazardPointers
+{
+public:
+    static constexpr size_t slots_per_thread = 2;
+
+    using Deleter = void (*)(void *);
+
+    // Slots of the calling thread, cleared when the thread exits.
+    static std::atomic<void *> *slots();
+
+    static void retire(void *pointer, Deleter deleter);
+
+    // Publishes the value of source in slot until source is seen unchanged.
+    template <typename Type>
+    static Type *protect(const std::atomic<Type *> &source, size_t slot)
+    {
+        std::atomic<void *> &hazard = slots()[slot];
+        Type *pointer = source.load();
+
+        while (true)
+        {
+            hazard.store(pointer);
+
+            Type *current = source.load();
+
+            if (current == pointer)
+                return pointer;
+
+            pointer = current;
+        }
+    }
+
+    static void clear(size_t slot)
+    {
+        slots()[slot].store(nullptr, std::memory_order_release);
+    }
+};
@@ -1,58 +1,109 @@
 #include <lifetime_helper/lifetime_helper.h>
 
-int LifetimeHelper::created_count = 0;
-int LifetimeHelper::alive_count = 0;
-
 // #define PRINT_LIFETIME
 
+std::atomic<int> LifetimeHelper::created_count = 0;
+std::atomic<int> LifetimeHelper::alive_count = 0;
+std::atomic<int64_t> LifetimeHelper::constructions = 0;
+std::atomic<int64_t> LifetimeHelper::copies = 0;
+std::atomic<int64_t> LifetimeHelper::moves = 0;
+std::atomic<int64_t> LifetimeHelper::copy_assigns = 0;
+std::atomic<int64_t> LifetimeHelper::move_assigns = 0;
+std::atomic<int64_t> LifetimeHelper::destructions = 0;
+
+#ifdef PRINT_LIFETIME
+std::atomic<bool> LifetimeHelper::printing = true;
+#else
+std::atomic<bool> LifetimeHelper::printing = false;
+#endif
+
+namespace
+{
+
+void increment(std::atomic<int64_t> &counter)
+{
+    counter.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace
+
+LifetimeCounters LifetimeCounters::operator-(const LifetimeCounters &other) const noexcept
+{
+    LifetimeCounters result;
+
+    result.constructions = constructions - other.constructions;
+    result.copies = copies - other.copies;
+    result.moves = moves - other.moves;
+    result.copy_assigns = copy_assigns - other.copy_assigns;
+    result.move_assigns = move_assigns - other.move_assigns;
+    result.destructions = destructions - other.destructions;
+
+    return result;
+}
+
+bool LifetimeCounters::operator==(const LifetimeCounters &other) const noexcept
+{
+    return constructions == other.constructions && copies == other.copies && moves == other.moves &&
+           copy_assigns == other.copy_assigns && move_assigns == other.move_assigns &&
+           destructions == other.destructions;
+}
+
+LifetimeHelper::Scope::Scope() : start_(LifetimeHelper::get_counters())
+{
+}
+
+LifetimeCounters LifetimeHelper::Scope::diff() const
+{
+    return LifetimeHelper::get_counters() - start_;
+}
+
 LifetimeHelper::LifetimeHelper()
 {
     number_ = ++created_count;
     ++alive_count;
+    increment(constructions);
 
-#ifdef PRINT_LIFETIME
-    std::cout << "Default contructed: " << number_ << '\n';
-#endif
+    if (printing)
+        std::cout << "Default contructed: " << number_ << '\n';
 };
 
 LifetimeHelper::LifetimeHelper(int n)
 {
     number_ = n;
     ++alive_count;
+    increment(constructions);
 
-#ifdef PRINT_LIFETIME
-    std::cout << "Value contructed: " << number_ << '\n';
-#endif
+    if (printing)
+        std::cout << "Value contructed: " << number_ << '\n';
 };
 
 LifetimeHelper::LifetimeHelper(const LifetimeHelper &oth)
 {
     number_ = ++created_count;
     ++alive_count;
+    increment(copies);
 
-#ifdef PRINT_LIFETIME
-    std::cout << "Copy-constructed: " << number_ << " from: " << oth.number_ << '\n';
-#endif
+    if (printing)
+        std::cout << "Copy-constructed: " << number_ << " from: " << oth.number_ << '\n';
 }
 
 LifetimeHelper::LifetimeHelper(LifetimeHelper &&oth) noexcept
 {
     number_ = ++created_count;
     ++alive_count;
+    increment(moves);
 
-#ifdef PRINT_LIFETIME
-    std::cout << "Move-constructed: " << number_ << " from: " << oth.number_ << '\n';
-#endif
+    if (printing)
+        std::cout << "Move-constructed: " << number_ << " from: " << oth.number_ << '\n';
 }
 
-LifetimeHelper &LifetimeHelper::operator=(LifetimeHelper &oth)
+LifetimeHelper &LifetimeHelper::operator=(const LifetimeHelper &oth)
 {
     number_ = oth.number_;
-    oth.number_ = -number_;
+    increment(copy_assigns);
 
-#ifdef PRINT_LIFETIME
-    std::cout << "Copy-assigned: " << number_ << '\n';
-#endif
+    if (printing)
+        std::cout << "Copy-assigned: " << number_ << '\n';
 
     return *this;
 }
@@ -61,10 +112,10 @@ LifetimeHelper &LifetimeHelper::operator=(LifetimeHelper &&oth) noexcept
 {
     number_ = oth.number_;
     oth.number_ = -number_;
+    increment(move_assigns);
 
-#ifdef PRINT_LIFETIME
-    std::cout << "Move-assigned: " << number_ << '\n';
-#endif
+    if (printing)
+        std::cout << "Move-assigned: " << number_ << '\n';
 
     return *this;
 }
@@ -72,10 +123,10 @@ LifetimeHelper &LifetimeHelper::operator=(LifetimeHelper &&oth) noexcept
 LifetimeHelper::~LifetimeHelper()
 {
     --alive_count;
+    increment(destructions);
 
-#ifdef PRINT_LIFETIME
-    std::cout << "Destructed: " << number_ << '\n';
-#endif
+    if (printing)
+        std::cout << "Destructed: " << number_ << '\n';
 }
 
 int LifetimeHelper::get_object_number() const
@@ -88,6 +139,25 @@ int LifetimeHelper::get_alive_count()
     return alive_count;
 }
 
+LifetimeCounters LifetimeHelper::get_counters()
+{
+    LifetimeCounters result;
+
+    result.constructions = constructions.load(std::memory_order_relaxed);
+    result.copies = copies.load(std::memory_order_relaxed);
+    result.moves = moves.load(std::memory_order_relaxed);
+    result.copy_assigns = copy_assigns.load(std::memory_order_relaxed);
+    result.move_assigns = move_assigns.load(std::memory_order_relaxed);
+    result.destructions = destructions.load(std::memory_order_relaxed);
+
+    return result;
+}
+
+void LifetimeHelper::set_printing(bool enabled)
+{
+    printing = enabled;
+}
+
 std::ostream &operator<<(std::ostream &out, const LifetimeHelper &obj)
 {
     out << "Printing the Liftime object #: " << obj.get_object_number() << '\n';
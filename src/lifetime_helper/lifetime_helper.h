@@ -1,25 +1,72 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <iostream>
 
+// Totals of the special member function calls made on LifetimeHelper objects.
+struct LifetimeCounters
+{
+    int64_t constructions = 0;
+    int64_t copies = 0;
+    int64_t moves = 0;
+    int64_t copy_assigns = 0;
+    int64_t move_assigns = 0;
+    int64_t destructions = 0;
+
+    int64_t alive() const noexcept
+    {
+        return constructions + copies + moves - destructions;
+    }
+
+    LifetimeCounters operator-(const LifetimeCounters &other) const noexcept;
+    bool operator==(const LifetimeCounters &other) const noexcept;
+};
+
 class LifetimeHelper
 {
+public:
+    // Takes a snapshot of the counters when created, diff() returns what
+    // happened since then.
+    class Scope
+    {
+    public:
+        Scope();
+
+        LifetimeCounters diff() const;
+
+    private:
+        LifetimeCounters start_;
+    };
+
 public:
     LifetimeHelper();
     LifetimeHelper(int n);
     LifetimeHelper(const LifetimeHelper &oth);
     LifetimeHelper(LifetimeHelper &&oth) noexcept;
-    LifetimeHelper &operator=(LifetimeHelper &oth);
+    LifetimeHelper &operator=(const LifetimeHelper &oth);
     LifetimeHelper &operator=(LifetimeHelper &&oth) noexcept;
     ~LifetimeHelper();
 
     int get_object_number() const;
     static int get_alive_count();
+    static LifetimeCounters get_counters();
+
+    // Printing every event to std::cout is off unless PRINT_LIFETIME is defined.
+    static void set_printing(bool enabled);
 
 private:
     int number_;
-    static int created_count;
-    static int alive_count;
+
+    static std::atomic<int> created_count;
+    static std::atomic<int> alive_count;
+    static std::atomic<int64_t> constructions;
+    static std::atomic<int64_t> copies;
+    static std::atomic<int64_t> moves;
+    static std::atomic<int64_t> copy_assigns;
+    static std::atomic<int64_t> move_assigns;
+    static std::atomic<int64_t> destructions;
+    static std::atomic<bool> printing;
 };
 
 std::ostream &operator<<(std::ostream &out, const LifetimeHelper &obj);
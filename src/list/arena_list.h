@@ -0,0 +1,746 @@
+#pragma once
+
+#include "compact_list_iterator.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// List whose nodes live in one contiguous, vector-backed arena and link to
+// each other through 32-bit indices. Elements are addressed by Handles that
+// stay valid until the element is erased, also across reallocation and
+// compact(). compact() rewrites the arena in traversal order, so iteration
+// over a compacted list is a sequential walk through memory. Iterators are
+// invalidated by compact() only.
+template <typename Type>
+class ArenaList
+{
+private:
+    static constexpr uint32_t npos = UINT32_MAX;
+
+    struct Node
+    {
+        Type *value() noexcept
+        {
+            return std::launder(reinterpret_cast<Type *>(storage_));
+        }
+
+        const Type *value() const noexcept
+        {
+            return std::launder(reinterpret_cast<const Type *>(storage_));
+        }
+
+        uint32_t prev_;
+        uint32_t next_;
+        uint32_t handle_;
+        alignas(Type) unsigned char storage_[sizeof(Type)];
+    };
+
+    // Maps a handle to its node. Freed entries are chained through node_ and
+    // bump their generation, so stale handles are recognised.
+    struct HandleEntry
+    {
+        uint32_t node_;
+        uint32_t generation_;
+    };
+
+    using Storage = ArenaList;
+    using Iter = CompactListIterator<ArenaList, Type>;
+    using ConstIter = CompactListIterator<ArenaList, const Type>;
+    using ReverseIter = std::reverse_iterator<Iter>;
+    using ConstReverseIter = std::reverse_iterator<ConstIter>;
+
+    static constexpr bool is_trivial_v = std::is_trivially_copyable_v<Type>;
+
+public: // Member types
+    using value_type = Type;
+    using iterator = Iter;
+    using const_iterator = ConstIter;
+
+    class Handle
+    {
+    public:
+        Handle() = default;
+
+        bool operator==(const Handle &other) const noexcept
+        {
+            return id_ == other.id_ && generation_ == other.generation_;
+        }
+
+        bool operator!=(const Handle &other) const noexcept
+        {
+            return !(*this == other);
+        }
+
+    private:
+        friend class ArenaList;
+
+        Handle(uint32_t id, uint32_t generation) : id_(id), generation_(generation)
+        {
+        }
+
+        uint32_t id_ = npos;
+        uint32_t generation_ = 0;
+    };
+
+public: // Special member functions
+    ArenaList() = default;
+
+    ArenaList(std::initializer_list<Type> values)
+    {
+        for (const Type &value : values)
+            emplace_back(value);
+    }
+
+    // Copies the arena as it is, so handles of other are valid in the copy.
+    // For trivially copyable types this is a single memcpy.
+    ArenaList(const ArenaList &other)
+        : handles_(other.handles_),
+          free_node_(other.free_node_),
+          free_handle_(other.free_handle_),
+          head_(other.head_),
+          tail_(other.tail_),
+          size_(other.size_)
+    {
+        if constexpr (is_trivial_v)
+        {
+            nodes_ = other.nodes_;
+        }
+        else
+        {
+            nodes_.reserve(other.nodes_.size());
+            nodes_.resize(other.nodes_.size());
+
+            copy_links(other.nodes_, nodes_);
+
+            uint32_t index = head_;
+
+            try
+            {
+                for (; index != npos; index = nodes_[index].next_)
+                    ::new (nodes_[index].storage_) Type(*other.nodes_[index].value());
+            }
+            catch (...)
+            {
+                for (uint32_t created = head_; created != index; created = nodes_[created].next_)
+                    std::destroy_at(nodes_[created].value());
+
+                throw;
+            }
+        }
+    }
+
+    ArenaList(ArenaList &&other) noexcept
+        : nodes_(std::move(other.nodes_)),
+          handles_(std::move(other.handles_)),
+          free_node_(std::exchange(other.free_node_, npos)),
+          free_handle_(std::exchange(other.free_handle_, npos)),
+          head_(std::exchange(other.head_, npos)),
+          tail_(std::exchange(other.tail_, npos)),
+          size_(std::exchange(other.size_, 0))
+    {
+        other.nodes_.clear();
+        other.handles_.clear();
+    }
+
+    ArenaList &operator=(const ArenaList &other)
+    {
+        if (this != &other)
+            ArenaList(other).swap(*this);
+
+        return *this;
+    }
+
+    ArenaList &operator=(ArenaList &&other) noexcept
+    {
+        if (this != &other)
+            ArenaList(std::move(other)).swap(*this);
+
+        return *this;
+    }
+
+    ~ArenaList()
+    {
+        destroy_values();
+    }
+
+public: // Size-related methods
+    size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    // Number of node slots in the arena, live or free.
+    size_t arena_size() const noexcept
+    {
+        return nodes_.size();
+    }
+
+    void reserve(size_t capacity)
+    {
+        if (capacity > nodes_.capacity())
+            reallocate(capacity);
+    }
+
+public: // Member access methods
+    Type &front() noexcept
+    {
+        return *nodes_[head_].value();
+    }
+
+    const Type &front() const noexcept
+    {
+        return *nodes_[head_].value();
+    }
+
+    Type &back() noexcept
+    {
+        return *nodes_[tail_].value();
+    }
+
+    const Type &back() const noexcept
+    {
+        return *nodes_[tail_].value();
+    }
+
+    Type &operator[](Handle handle) noexcept
+    {
+        return *nodes_[handles_[handle.id_].node_].value();
+    }
+
+    const Type &operator[](Handle handle) const noexcept
+    {
+        return *nodes_[handles_[handle.id_].node_].value();
+    }
+
+    bool contains(Handle handle) const noexcept
+    {
+        return handle.id_ < handles_.size() && handles_[handle.id_].generation_ == handle.generation_;
+    }
+
+public: // Modifying methods
+    Handle push_front(const Type &value)
+    {
+        return emplace_front(value);
+    }
+
+    Handle push_front(Type &&value)
+    {
+        return emplace_front(std::move(value));
+    }
+
+    template <typename... Types>
+    Handle emplace_front(Types &&...args)
+    {
+        uint32_t index = create_node(std::forward<Types>(args)...);
+
+        link_before(head_, index);
+
+        return handle_of(index);
+    }
+
+    Handle push_back(const Type &value)
+    {
+        return emplace_back(value);
+    }
+
+    Handle push_back(Type &&value)
+    {
+        return emplace_back(std::move(value));
+    }
+
+    template <typename... Types>
+    Handle emplace_back(Types &&...args)
+    {
+        uint32_t index = create_node(std::forward<Types>(args)...);
+
+        link_before(npos, index);
+
+        return handle_of(index);
+    }
+
+    void pop_front() noexcept
+    {
+        erase_index(head_);
+    }
+
+    void pop_back() noexcept
+    {
+        erase_index(tail_);
+    }
+
+    void clear() noexcept
+    {
+        while (head_ != npos)
+            erase_index(head_);
+    }
+
+    void swap(ArenaList &other) noexcept
+    {
+        nodes_.swap(other.nodes_);
+        handles_.swap(other.handles_);
+        std::swap(free_node_, other.free_node_);
+        std::swap(free_handle_, other.free_handle_);
+        std::swap(head_, other.head_);
+        std::swap(tail_, other.tail_);
+        std::swap(size_, other.size_);
+    }
+
+    // Moves the elements into a new arena of exactly size() nodes, laid out
+    // in traversal order. Handles stay valid, iterators don't.
+    void compact()
+    {
+        std::vector<Node> nodes;
+        nodes.reserve(size_);
+        nodes.resize(size_);
+
+        relocate_values(nodes);
+
+        uint32_t position = 0;
+
+        for (uint32_t index = head_; index != npos; index = nodes_[index].next_, ++position)
+        {
+            Node &node = nodes[position];
+
+            node.prev_ = position == 0 ? npos : position - 1;
+            node.next_ = position + 1 == size_ ? npos : position + 1;
+            node.handle_ = nodes_[index].handle_;
+
+            handles_[node.handle_].node_ = position;
+        }
+
+        nodes_.swap(nodes);
+        free_node_ = npos;
+        head_ = size_ == 0 ? npos : 0;
+        tail_ = size_ == 0 ? npos : static_cast<uint32_t>(size_ - 1);
+    }
+
+public: // Algorithms
+    void sort()
+    {
+        sort(std::less<Type>());
+    }
+
+    // Stable sort of the node indices, the nodes are relinked afterwards.
+    // If compare throws the list is left unchanged.
+    template <typename CmpFunc>
+    void sort(CmpFunc compare)
+    {
+        if (size_ < 2)
+            return;
+
+        std::vector<uint32_t> order;
+        order.reserve(size_);
+
+        for (uint32_t index = head_; index != npos; index = nodes_[index].next_)
+            order.push_back(index);
+
+        std::stable_sort(order.begin(), order.end(), [this, &compare](uint32_t lhs, uint32_t rhs)
+                         { return compare(*nodes_[lhs].value(), *nodes_[rhs].value()); });
+
+        uint32_t prev = npos;
+
+        for (uint32_t index : order)
+        {
+            nodes_[index].prev_ = prev;
+
+            if (prev != npos)
+                nodes_[prev].next_ = index;
+
+            prev = index;
+        }
+
+        nodes_[prev].next_ = npos;
+        head_ = order.front();
+        tail_ = prev;
+    }
+
+    void reverse() noexcept
+    {
+        for (uint32_t index = head_; index != npos;)
+        {
+            Node &node = nodes_[index];
+
+            std::swap(node.prev_, node.next_);
+            index = node.prev_;
+        }
+
+        std::swap(head_, tail_);
+    }
+
+public: // Iterator-related methods
+    Handle handle(ConstIter it) const noexcept
+    {
+        return handle_of(it.index_);
+    }
+
+    Iter find(Handle handle) noexcept
+    {
+        return Iter(this, contains(handle) ? handles_[handle.id_].node_ : npos);
+    }
+
+    ConstIter find(Handle handle) const noexcept
+    {
+        return ConstIter(this, contains(handle) ? handles_[handle.id_].node_ : npos);
+    }
+
+    Iter insert(ConstIter position, const Type &value)
+    {
+        return emplace(position, value);
+    }
+
+    Iter insert(ConstIter position, Type &&value)
+    {
+        return emplace(position, std::move(value));
+    }
+
+    template <typename... Types>
+    Iter emplace(ConstIter position, Types &&...args)
+    {
+        uint32_t index = create_node(std::forward<Types>(args)...);
+
+        link_before(position.index_, index);
+
+        return Iter(this, index);
+    }
+
+    Iter erase(ConstIter position) noexcept
+    {
+        uint32_t next = nodes_[position.index_].next_;
+
+        erase_index(position.index_);
+
+        return Iter(this, next);
+    }
+
+    void erase(Handle handle) noexcept
+    {
+        erase_index(handles_[handle.id_].node_);
+    }
+
+public: // Fabric methods
+    Iter begin() noexcept
+    {
+        return Iter(this, head_);
+    }
+
+    Iter end() noexcept
+    {
+        return Iter(this, npos);
+    }
+
+    ConstIter begin() const noexcept
+    {
+        return cbegin();
+    }
+
+    ConstIter end() const noexcept
+    {
+        return cend();
+    }
+
+    ConstIter cbegin() const noexcept
+    {
+        return ConstIter(this, head_);
+    }
+
+    ConstIter cend() const noexcept
+    {
+        return ConstIter(this, npos);
+    }
+
+    ReverseIter rbegin() noexcept
+    {
+        return ReverseIter(end());
+    }
+
+    ReverseIter rend() noexcept
+    {
+        return ReverseIter(begin());
+    }
+
+    ConstReverseIter crbegin() const noexcept
+    {
+        return ConstReverseIter(cend());
+    }
+
+    ConstReverseIter crend() const noexcept
+    {
+        return ConstReverseIter(cbegin());
+    }
+
+private: // Internal logic
+    Type *value(uint32_t index) noexcept
+    {
+        return nodes_[index].value();
+    }
+
+    const Type *value(uint32_t index) const noexcept
+    {
+        return nodes_[index].value();
+    }
+
+    ArenaList *storage() noexcept
+    {
+        return this;
+    }
+
+    const ArenaList *storage() const noexcept
+    {
+        return this;
+    }
+
+    uint32_t next_index(uint32_t index) const noexcept
+    {
+        return nodes_[index].next_;
+    }
+
+    uint32_t prev_index(uint32_t index) const noexcept
+    {
+        return index == npos ? tail_ : nodes_[index].prev_;
+    }
+
+    Handle handle_of(uint32_t index) const noexcept
+    {
+        uint32_t id = nodes_[index].handle_;
+
+        return Handle(id, handles_[id].generation_);
+    }
+
+    // The arguments may refer to an element of this list, so when the arena
+    // has to grow the value is built before the old storage goes away.
+    template <typename... Types>
+    uint32_t create_node(Types &&...args)
+    {
+        if (free_node_ == npos && nodes_.size() == nodes_.capacity())
+        {
+            Type value(std::forward<Types>(args)...);
+
+            reserve_slots();
+            return construct_node(std::move(value));
+        }
+
+        reserve_slots();
+        return construct_node(std::forward<Types>(args)...);
+    }
+
+    // Makes sure a free node and a free handle are available, after this
+    // taking them can't fail.
+    void reserve_slots()
+    {
+        if (free_node_ == npos)
+        {
+            if (nodes_.size() == npos)
+                throw std::length_error("ArenaList ran out of 32-bit indices");
+
+            if (nodes_.size() == nodes_.capacity())
+                reallocate(std::max<size_t>(16, nodes_.capacity() * 2));
+
+            nodes_.emplace_back();
+            release_node(static_cast<uint32_t>(nodes_.size() - 1));
+        }
+
+        if (free_handle_ == npos)
+        {
+            handles_.push_back(HandleEntry{npos, 0});
+            free_handle_ = static_cast<uint32_t>(handles_.size() - 1);
+        }
+    }
+
+    template <typename... Types>
+    uint32_t construct_node(Types &&...args)
+    {
+        uint32_t index = free_node_;
+        Node &node = nodes_[index];
+
+        ::new (node.storage_) Type(std::forward<Types>(args)...);
+
+        free_node_ = node.next_;
+
+        uint32_t id = free_handle_;
+        free_handle_ = handles_[id].node_;
+        handles_[id].node_ = index;
+        node.handle_ = id;
+
+        return index;
+    }
+
+    void release_node(uint32_t index) noexcept
+    {
+        nodes_[index].handle_ = npos;
+        nodes_[index].next_ = free_node_;
+        free_node_ = index;
+    }
+
+    void erase_index(uint32_t index) noexcept
+    {
+        Node &node = nodes_[index];
+        HandleEntry &entry = handles_[node.handle_];
+
+        unlink(index);
+        std::destroy_at(node.value());
+
+        ++entry.generation_;
+        entry.node_ = free_handle_;
+        free_handle_ = node.handle_;
+
+        release_node(index);
+        --size_;
+    }
+
+    void link_before(uint32_t position, uint32_t index) noexcept
+    {
+        uint32_t prev = prev_index(position);
+        Node &node = nodes_[index];
+
+        node.prev_ = prev;
+        node.next_ = position;
+
+        if (prev == npos)
+            head_ = index;
+        else
+            nodes_[prev].next_ = index;
+
+        if (position == npos)
+            tail_ = index;
+        else
+            nodes_[position].prev_ = index;
+
+        ++size_;
+    }
+
+    void unlink(uint32_t index) noexcept
+    {
+        uint32_t prev = nodes_[index].prev_;
+        uint32_t next = nodes_[index].next_;
+
+        if (prev == npos)
+            head_ = next;
+        else
+            nodes_[prev].next_ = next;
+
+        if (next == npos)
+            tail_ = prev;
+        else
+            nodes_[next].prev_ = prev;
+    }
+
+    // Moves the arena into a larger buffer keeping every node at its index.
+    void reallocate(size_t capacity)
+    {
+        std::vector<Node> nodes;
+        nodes.reserve(capacity);
+
+        if constexpr (is_trivial_v)
+        {
+            nodes.assign(nodes_.begin(), nodes_.end());
+        }
+        else
+        {
+            nodes.resize(nodes_.size());
+            copy_links(nodes_, nodes);
+
+            std::vector<uint32_t> order;
+            order.reserve(size_);
+
+            for (uint32_t index = head_; index != npos; index = nodes_[index].next_)
+                order.push_back(index);
+
+            move_values(order, nodes, [](size_t, uint32_t index) { return index; });
+        }
+
+        nodes_.swap(nodes);
+    }
+
+    // Moves the live values into target in traversal order.
+    void relocate_values(std::vector<Node> &target)
+    {
+        std::vector<uint32_t> order;
+        order.reserve(size_);
+
+        for (uint32_t index = head_; index != npos; index = nodes_[index].next_)
+            order.push_back(index);
+
+        move_values(order, target, [](size_t position, uint32_t) { return static_cast<uint32_t>(position); });
+    }
+
+    // Builds every value of order in target first and only destroys the
+    // sources afterwards, so a throwing copy leaves the arena untouched.
+    template <typename TargetIndex>
+    void move_values(const std::vector<uint32_t> &order, std::vector<Node> &target, TargetIndex target_index)
+    {
+        if constexpr (is_trivial_v)
+        {
+            for (size_t position = 0; position < order.size(); ++position)
+                std::memcpy(target[target_index(position, order[position])].storage_, nodes_[order[position]].storage_,
+                            sizeof(Type));
+
+            return;
+        }
+
+        size_t position = 0;
+
+        try
+        {
+            for (; position < order.size(); ++position)
+            {
+                ::new (target[target_index(position, order[position])].storage_)
+                    Type(std::move_if_noexcept(*nodes_[order[position]].value()));
+            }
+        }
+        catch (...)
+        {
+            for (size_t created = 0; created < position; ++created)
+                std::destroy_at(target[target_index(created, order[created])].value());
+
+            throw;
+        }
+
+        for (uint32_t index : order)
+            std::destroy_at(nodes_[index].value());
+    }
+
+    static void copy_links(const std::vector<Node> &source, std::vector<Node> &target) noexcept
+    {
+        for (size_t index = 0; index < source.size(); ++index)
+        {
+            target[index].prev_ = source[index].prev_;
+            target[index].next_ = source[index].next_;
+            target[index].handle_ = source[index].handle_;
+        }
+    }
+
+    void destroy_values() noexcept
+    {
+        if constexpr (!std::is_trivially_destructible_v<Type>)
+        {
+            for (uint32_t index = head_; index != npos; index = nodes_[index].next_)
+                std::destroy_at(nodes_[index].value());
+        }
+    }
+
+private:
+    template <class, typename>
+    friend class CompactListIterator;
+
+private:
+    std::vector<Node> nodes_;
+    std::vector<HandleEntry> handles_;
+    uint32_t free_node_ = npos;
+    uint32_t free_handle_ = npos;
+    uint32_t head_ = npos;
+    uint32_t tail_ = npos;
+    size_t size_ = 0;
+};
@@ -0,0 +1,247 @@
+#pragma once
+
+#include "prefetch.h"
+
+#include <cstddef>
+
+// Stable natural merge sort of a null-terminated chain of links, relinking
+// only. Link is any node type with prev_ and next_ pointers to Link and
+// precedes(lhs, rhs) tells whether lhs orders before rhs. Runs already in
+// the input are taken as they are and merged under the TimSort length
+// invariants, so presorted and reversed input sorts in linear time.
+template <typename Link>
+class ChainSort
+{
+public:
+    // Null-terminated chain whose prev_ links are valid past its head.
+    struct Run
+    {
+        Link *head_ = nullptr;
+        Link *tail_ = nullptr;
+        size_t length_ = 0;
+    };
+
+    // Sorts a null-terminated run in place. If precedes throws, the run's head
+    // still leads to all of its nodes, in unspecified order.
+    template <typename Precedes>
+    static void sort(Run &run, Precedes &precedes)
+    {
+        Link *rest = run.head_;
+        RunStack runs;
+
+        try
+        {
+            while (rest != nullptr)
+            {
+                runs.push(take_run(rest, precedes));
+                runs.collapse(precedes);
+            }
+
+            runs.collapse_all(precedes);
+        }
+        catch (...)
+        {
+            run.head_ = runs.concatenate(rest);
+            throw;
+        }
+
+        run = runs.runs_[0];
+    }
+
+private:
+    // Pending runs kept under the TimSort length invariants, which bounds the
+    // stack depth and keeps merges balanced.
+    struct RunStack
+    {
+        void push(Run run) noexcept
+        {
+            runs_[height_++] = run;
+        }
+
+        template <typename Precedes>
+        void collapse(Precedes &precedes)
+        {
+            while (height_ > 1)
+            {
+                size_t n = height_ - 2;
+
+                if ((n > 0 && runs_[n - 1].length_ <= runs_[n].length_ + runs_[n + 1].length_) ||
+                    (n > 1 && runs_[n - 2].length_ <= runs_[n - 1].length_ + runs_[n].length_))
+                {
+                    if (runs_[n - 1].length_ < runs_[n + 1].length_)
+                        --n;
+                }
+                else if (runs_[n].length_ > runs_[n + 1].length_)
+                {
+                    break;
+                }
+
+                merge_at(n, precedes);
+            }
+        }
+
+        template <typename Precedes>
+        void collapse_all(Precedes &precedes)
+        {
+            while (height_ > 1)
+                merge_at(height_ - 2, precedes);
+        }
+
+        template <typename Precedes>
+        void merge_at(size_t n, Precedes &precedes)
+        {
+            Run rhs = runs_[n + 1];
+
+            if (n + 2 < height_)
+                runs_[n + 1] = runs_[n + 2];
+
+            --height_;
+
+            merge_runs(runs_[n], rhs, precedes);
+        }
+
+        Link *concatenate(Link *rest) noexcept
+        {
+            Link *head = nullptr;
+            Link **tail = &head;
+
+            for (size_t i = 0; i < height_; ++i)
+            {
+                *tail = runs_[i].head_;
+
+                while (*tail != nullptr)
+                    tail = &(*tail)->next_;
+            }
+
+            *tail = rest;
+            height_ = 0;
+
+            return head;
+        }
+
+        Run runs_[128];
+        size_t height_ = 0;
+    };
+
+    // Cuts the next ascending or strictly descending run off the front of a
+    // null-terminated chain. Descending runs are reversed while they are cut,
+    // which keeps the sort stable.
+    template <typename Precedes>
+    static Run take_run(Link *&rest, Precedes &precedes)
+    {
+        Link *head = rest;
+        Link *next = head->next_;
+        size_t length = 1;
+
+        if (next != nullptr && precedes(next, head))
+        {
+            Link *reversed = head;
+            head->next_ = nullptr;
+
+            try
+            {
+                while (next != nullptr && precedes(next, reversed))
+                {
+                    Link *after = next->next_;
+                    next->next_ = reversed;
+                    reversed->prev_ = next;
+                    reversed = next;
+                    next = after;
+                    ++length;
+                }
+            }
+            catch (...)
+            {
+                head->next_ = next;
+                rest = reversed;
+                throw;
+            }
+
+            rest = next;
+            return Run{reversed, head, length};
+        }
+
+        Link *tail = head;
+
+        while (next != nullptr && !precedes(next, tail))
+        {
+            tail = next;
+            next = next->next_;
+            ++length;
+        }
+
+        tail->next_ = nullptr;
+        rest = next;
+
+        return Run{head, tail, length};
+    }
+
+    // Stable merge of rhs into lhs that keeps prev_ links valid, so no extra
+    // pass over the nodes is needed afterwards. If precedes throws, lhs holds
+    // every node of both runs in unspecified order.
+    template <typename Precedes>
+    static void merge_runs(Run &lhs, Run rhs, Precedes &precedes)
+    {
+        Link *left = lhs.head_;
+        Link *right = rhs.head_;
+        Link *head = nullptr;
+        Link *tail = nullptr;
+
+        auto append = [&head, &tail](Link *node) noexcept
+        {
+            if (tail != nullptr)
+                tail->next_ = node;
+            else
+                head = node;
+
+            node->prev_ = tail;
+            tail = node;
+        };
+
+        try
+        {
+            while (left != nullptr && right != nullptr)
+            {
+                if (precedes(right, left))
+                {
+                    append(right);
+                    right = right->next_;
+                    prefetch_for_write(right != nullptr ? right->next_ : nullptr);
+                }
+                else
+                {
+                    append(left);
+                    left = left->next_;
+                    prefetch_for_write(left != nullptr ? left->next_ : nullptr);
+                }
+            }
+        }
+        catch (...)
+        {
+            if (left != nullptr)
+            {
+                append(left);
+                tail = lhs.tail_;
+            }
+
+            if (right != nullptr)
+                append(right);
+
+            lhs.head_ = head;
+            throw;
+        }
+
+        if (left != nullptr)
+        {
+            append(left);
+            tail = lhs.tail_;
+        }
+        else
+        {
+            append(right);
+            tail = rhs.tail_;
+        }
+
+        lhs = Run{head, tail, lhs.length_ + rhs.length_};
+    }
+};
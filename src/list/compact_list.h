@@ -0,0 +1,623 @@
+#pragma once
+
+#include "compact_list_iterator.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Pool of list nodes linked by 32-bit indices instead of pointers. Nodes are
+// carved out of fixed size chunks, so elements never move once created.
+// Several CompactLists can share one arena, which is what lets them splice
+// nodes between each other. The arena is not thread-safe.
+template <typename Type, size_t NodesPerChunk = 4096>
+class CompactNodeArena
+{
+    static_assert(NodesPerChunk > 0 && (NodesPerChunk & (NodesPerChunk - 1)) == 0,
+                  "Chunk size has to be a power of two");
+
+public:
+    static constexpr uint32_t npos = UINT32_MAX;
+
+    struct Node
+    {
+        Type *value() noexcept
+        {
+            return std::launder(reinterpret_cast<Type *>(storage_));
+        }
+
+        const Type *value() const noexcept
+        {
+            return std::launder(reinterpret_cast<const Type *>(storage_));
+        }
+
+        uint32_t prev_;
+        uint32_t next_;
+        alignas(Type) unsigned char storage_[sizeof(Type)];
+    };
+
+public: // Special member functions
+    CompactNodeArena() = default;
+
+    CompactNodeArena(const CompactNodeArena &) = delete;
+    CompactNodeArena &operator=(const CompactNodeArena &) = delete;
+
+public: // Allocation
+    template <typename... Types>
+    uint32_t create(Types &&...args)
+    {
+        uint32_t index = allocate();
+
+        try
+        {
+            ::new (node(index).storage_) Type(std::forward<Types>(args)...);
+        }
+        catch (...)
+        {
+            release(index);
+            throw;
+        }
+
+        return index;
+    }
+
+    void destroy(uint32_t index) noexcept
+    {
+        std::destroy_at(node(index).value());
+        release(index);
+    }
+
+    Node &node(uint32_t index) noexcept
+    {
+        return chunks_[index / NodesPerChunk][index % NodesPerChunk];
+    }
+
+    const Node &node(uint32_t index) const noexcept
+    {
+        return chunks_[index / NodesPerChunk][index % NodesPerChunk];
+    }
+
+    Type *value(uint32_t index) noexcept
+    {
+        return node(index).value();
+    }
+
+    const Type *value(uint32_t index) const noexcept
+    {
+        return node(index).value();
+    }
+
+    uint32_t next_index(uint32_t index) const noexcept
+    {
+        return node(index).next_;
+    }
+
+    uint32_t prev_index(uint32_t index) const noexcept
+    {
+        return node(index).prev_;
+    }
+
+    size_t used() const noexcept
+    {
+        return used_;
+    }
+
+    size_t capacity() const noexcept
+    {
+        return chunks_.size() * NodesPerChunk;
+    }
+
+private: // Internal logic
+    uint32_t allocate()
+    {
+        if (free_list_ != npos)
+        {
+            uint32_t index = free_list_;
+            free_list_ = node(index).next_;
+            ++used_;
+
+            return index;
+        }
+
+        if (next_unused_ == capacity())
+        {
+            if (capacity() + NodesPerChunk > npos)
+                throw std::length_error("CompactNodeArena ran out of 32-bit indices");
+
+            chunks_.emplace_back(new Node[NodesPerChunk]);
+        }
+
+        ++used_;
+
+        return next_unused_++;
+    }
+
+    void release(uint32_t index) noexcept
+    {
+        node(index).next_ = free_list_;
+        free_list_ = index;
+        --used_;
+    }
+
+private:
+    std::vector<std::unique_ptr<Node[]>> chunks_;
+    uint32_t free_list_ = npos;
+    uint32_t next_unused_ = 0;
+    size_t used_ = 0;
+};
+
+// Doubly linked list whose nodes live in a CompactNodeArena and link to each
+// other through 32-bit indices. For small elements this halves the link
+// overhead of List and drops the per-node heap header. Lists sharing an
+// arena splice by relinking; between different arenas elements are moved.
+// Copies share the arena of their source.
+template <typename Type, size_t NodesPerChunk = 4096>
+class CompactList
+{
+public:
+    using Arena = CompactNodeArena<Type, NodesPerChunk>;
+
+private:
+    using Node = typename Arena::Node;
+    using Storage = Arena;
+    using Iter = CompactListIterator<CompactList, Type>;
+    using ConstIter = CompactListIterator<CompactList, const Type>;
+    using ReverseIter = std::reverse_iterator<Iter>;
+    using ConstReverseIter = std::reverse_iterator<ConstIter>;
+
+    static constexpr uint32_t npos = Arena::npos;
+
+public: // Member types
+    using value_type = Type;
+    using iterator = Iter;
+    using const_iterator = ConstIter;
+
+public: // Special member functions
+    CompactList() : arena_(std::make_shared<Arena>())
+    {
+    }
+
+    explicit CompactList(std::shared_ptr<Arena> arena) : arena_(std::move(arena))
+    {
+    }
+
+    CompactList(std::initializer_list<Type> values) : CompactList()
+    {
+        for (const Type &value : values)
+            push_back(value);
+    }
+
+    CompactList(const CompactList &other) : arena_(other.arena_)
+    {
+        for (const Type &value : other)
+            push_back(value);
+    }
+
+    CompactList(CompactList &&other) noexcept
+        : arena_(other.arena_),
+          head_(std::exchange(other.head_, npos)),
+          tail_(std::exchange(other.tail_, npos)),
+          size_(std::exchange(other.size_, 0))
+    {
+    }
+
+    CompactList &operator=(const CompactList &other)
+    {
+        if (this != &other)
+            CompactList(other).swap(*this);
+
+        return *this;
+    }
+
+    CompactList &operator=(CompactList &&other) noexcept
+    {
+        if (this != &other)
+            CompactList(std::move(other)).swap(*this);
+
+        return *this;
+    }
+
+    ~CompactList()
+    {
+        clear();
+    }
+
+public: // Size-related methods
+    size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    const std::shared_ptr<Arena> &get_arena() const noexcept
+    {
+        return arena_;
+    }
+
+public: // Member access methods
+    Type &front() noexcept
+    {
+        return *value(head_);
+    }
+
+    const Type &front() const noexcept
+    {
+        return *value(head_);
+    }
+
+    Type &back() noexcept
+    {
+        return *value(tail_);
+    }
+
+    const Type &back() const noexcept
+    {
+        return *value(tail_);
+    }
+
+public: // Modifying methods
+    void push_front(const Type &value)
+    {
+        emplace_front(value);
+    }
+
+    void push_front(Type &&value)
+    {
+        emplace_front(std::move(value));
+    }
+
+    template <typename... Types>
+    void emplace_front(Types &&...args)
+    {
+        link_before(head_, arena_->create(std::forward<Types>(args)...));
+    }
+
+    void push_back(const Type &value)
+    {
+        emplace_back(value);
+    }
+
+    void push_back(Type &&value)
+    {
+        emplace_back(std::move(value));
+    }
+
+    template <typename... Types>
+    void emplace_back(Types &&...args)
+    {
+        link_before(npos, arena_->create(std::forward<Types>(args)...));
+    }
+
+    void pop_front() noexcept
+    {
+        erase_index(head_);
+    }
+
+    void pop_back() noexcept
+    {
+        erase_index(tail_);
+    }
+
+    void clear() noexcept
+    {
+        while (head_ != npos)
+        {
+            uint32_t next = node(head_).next_;
+            arena_->destroy(head_);
+            head_ = next;
+        }
+
+        tail_ = npos;
+        size_ = 0;
+    }
+
+    void swap(CompactList &other) noexcept
+    {
+        std::swap(arena_, other.arena_);
+        std::swap(head_, other.head_);
+        std::swap(tail_, other.tail_);
+        std::swap(size_, other.size_);
+    }
+
+public: // Algorithms
+    void sort()
+    {
+        sort(std::less<Type>());
+    }
+
+    // Stable sort of the node indices, the nodes are relinked afterwards.
+    // If compare throws the list is left unchanged.
+    template <typename CmpFunc>
+    void sort(CmpFunc compare)
+    {
+        if (size_ < 2)
+            return;
+
+        std::vector<uint32_t> order;
+        order.reserve(size_);
+
+        for (uint32_t index = head_; index != npos; index = node(index).next_)
+            order.push_back(index);
+
+        std::stable_sort(order.begin(), order.end(),
+                         [this, &compare](uint32_t lhs, uint32_t rhs) { return compare(*value(lhs), *value(rhs)); });
+
+        uint32_t prev = npos;
+
+        for (uint32_t index : order)
+        {
+            node(index).prev_ = prev;
+
+            if (prev != npos)
+                node(prev).next_ = index;
+
+            prev = index;
+        }
+
+        node(prev).next_ = npos;
+        head_ = order.front();
+        tail_ = prev;
+    }
+
+    void reverse() noexcept
+    {
+        for (uint32_t index = head_; index != npos;)
+        {
+            Node &current = node(index);
+
+            std::swap(current.prev_, current.next_);
+            index = current.prev_;
+        }
+
+        std::swap(head_, tail_);
+    }
+
+    void splice(ConstIter position, CompactList &other)
+    {
+        if (this == &other || other.empty())
+            return;
+
+        if (arena_ != other.arena_)
+        {
+            splice(position, other, other.cbegin(), other.cend());
+            return;
+        }
+
+        link_range_before(position.index_, other.head_, other.tail_);
+        size_ += std::exchange(other.size_, 0);
+        other.head_ = other.tail_ = npos;
+    }
+
+    void splice(ConstIter position, CompactList &other, ConstIter begin, ConstIter end)
+    {
+        if (begin == end)
+            return;
+
+        if (arena_ != other.arena_)
+        {
+            while (begin != end)
+                splice(position, other, begin++);
+
+            return;
+        }
+
+        uint32_t first = begin.index_;
+        uint32_t last = other.prev_index(end.index_);
+        size_t distance = 0;
+
+        if (this != &other)
+        {
+            for (uint32_t index = first; index != end.index_; index = node(index).next_)
+                ++distance;
+        }
+
+        other.unlink_range(first, last);
+        link_range_before(position.index_, first, last);
+
+        other.size_ -= distance;
+        size_ += distance;
+    }
+
+    void splice(ConstIter position, CompactList &other, ConstIter it)
+    {
+        if (arena_ != other.arena_)
+        {
+            emplace(position, std::move(const_cast<Type &>(*it)));
+            other.erase(it);
+            return;
+        }
+
+        if (position.index_ == it.index_ || position.index_ == node(it.index_).next_)
+            return;
+
+        other.unlink_range(it.index_, it.index_);
+        link_before(position.index_, it.index_);
+
+        --other.size_;
+    }
+
+public: // Iterator-related methods
+    Iter insert(ConstIter position, const Type &value)
+    {
+        return emplace(position, value);
+    }
+
+    Iter insert(ConstIter position, Type &&value)
+    {
+        return emplace(position, std::move(value));
+    }
+
+    template <typename... Types>
+    Iter emplace(ConstIter position, Types &&...args)
+    {
+        uint32_t index = arena_->create(std::forward<Types>(args)...);
+
+        link_before(position.index_, index);
+
+        return Iter(this, index);
+    }
+
+    Iter erase(ConstIter position) noexcept
+    {
+        uint32_t next = node(position.index_).next_;
+
+        erase_index(position.index_);
+
+        return Iter(this, next);
+    }
+
+public: // Fabric methods
+    Iter begin() noexcept
+    {
+        return Iter(this, head_);
+    }
+
+    Iter end() noexcept
+    {
+        return Iter(this, npos);
+    }
+
+    ConstIter begin() const noexcept
+    {
+        return cbegin();
+    }
+
+    ConstIter end() const noexcept
+    {
+        return cend();
+    }
+
+    ConstIter cbegin() const noexcept
+    {
+        return ConstIter(this, head_);
+    }
+
+    ConstIter cend() const noexcept
+    {
+        return ConstIter(this, npos);
+    }
+
+    ReverseIter rbegin() noexcept
+    {
+        return ReverseIter(end());
+    }
+
+    ReverseIter rend() noexcept
+    {
+        return ReverseIter(begin());
+    }
+
+    ConstReverseIter crbegin() const noexcept
+    {
+        return ConstReverseIter(cend());
+    }
+
+    ConstReverseIter crend() const noexcept
+    {
+        return ConstReverseIter(cbegin());
+    }
+
+private: // Internal logic
+    Node &node(uint32_t index) noexcept
+    {
+        return arena_->node(index);
+    }
+
+    const Node &node(uint32_t index) const noexcept
+    {
+        return arena_->node(index);
+    }
+
+    Type *value(uint32_t index) noexcept
+    {
+        return node(index).value();
+    }
+
+    const Type *value(uint32_t index) const noexcept
+    {
+        return node(index).value();
+    }
+
+    Arena *storage() noexcept
+    {
+        return arena_.get();
+    }
+
+    const Arena *storage() const noexcept
+    {
+        return arena_.get();
+    }
+
+    uint32_t prev_index(uint32_t index) const noexcept
+    {
+        return index == npos ? tail_ : node(index).prev_;
+    }
+
+    void link_before(uint32_t position, uint32_t index) noexcept
+    {
+        link_range_before(position, index, index);
+        ++size_;
+    }
+
+    // Links the detached chain [first, last] in front of position, size_ is
+    // left to the caller.
+    void link_range_before(uint32_t position, uint32_t first, uint32_t last) noexcept
+    {
+        uint32_t prev = prev_index(position);
+
+        node(first).prev_ = prev;
+        node(last).next_ = position;
+
+        if (prev == npos)
+            head_ = first;
+        else
+            node(prev).next_ = first;
+
+        if (position == npos)
+            tail_ = last;
+        else
+            node(position).prev_ = last;
+    }
+
+    void unlink_range(uint32_t first, uint32_t last) noexcept
+    {
+        uint32_t prev = node(first).prev_;
+        uint32_t next = node(last).next_;
+
+        if (prev == npos)
+            head_ = next;
+        else
+            node(prev).next_ = next;
+
+        if (next == npos)
+            tail_ = prev;
+        else
+            node(next).prev_ = prev;
+    }
+
+    void erase_index(uint32_t index) noexcept
+    {
+        unlink_range(index, index);
+        arena_->destroy(index);
+        --size_;
+    }
+
+private:
+    template <class, typename>
+    friend class CompactListIterator;
+
+private:
+    std::shared_ptr<Arena> arena_;
+    uint32_t head_ = npos;
+    uint32_t tail_ = npos;
+    size_t size_ = 0;
+};
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+
+template <class ListType, typename Type>
+class CompactListIterator
+{
+public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = std::remove_const_t<Type>;
+    using pointer = Type *;
+    using reference = Type &;
+    using difference_type = std::ptrdiff_t;
+
+private:
+    using DeConstedType = std::remove_const_t<Type>;
+    using DeConstedIter = CompactListIterator<ListType, DeConstedType>;
+    using Owner = std::conditional_t<std::is_const_v<Type>, const ListType, ListType>;
+    using Storage =
+        std::conditional_t<std::is_const_v<Type>, const typename ListType::Storage, typename ListType::Storage>;
+
+public:
+    CompactListIterator(Owner *list, uint32_t index) : storage_(list->storage()), list_(list), index_(index)
+    {
+    }
+
+    CompactListIterator(const CompactListIterator &other) = default;
+
+    template <typename OtherIter,
+              typename = std::enable_if_t<std::is_const_v<Type> && std::is_same_v<OtherIter, DeConstedIter>>>
+    CompactListIterator(const OtherIter &other)
+        : storage_(other.storage_), list_(other.list_), index_(other.index_)
+    {
+    }
+
+    CompactListIterator &operator=(const CompactListIterator &other) = default;
+
+    reference operator*() const
+    {
+        return *storage_->value(index_);
+    }
+
+    pointer operator->() const
+    {
+        return storage_->value(index_);
+    }
+
+    // Nodes are reached through the storage the list links them in, which
+    // lists sharing an arena share as well. That keeps iterators valid when
+    // their node is spliced into another list.
+    CompactListIterator &operator++()
+    {
+        index_ = storage_->next_index(index_);
+        return *this;
+    }
+
+    CompactListIterator operator++(int)
+    {
+        CompactListIterator temp = *this;
+        ++*this;
+        return temp;
+    }
+
+    // Decrementing end() needs the tail of the list the iterator came from,
+    // which is why it keeps the list as well. An iterator spliced into
+    // another list and walked off its end can't be decremented.
+    CompactListIterator &operator--()
+    {
+        index_ = index_ == ListType::npos ? list_->prev_index(index_) : storage_->prev_index(index_);
+        return *this;
+    }
+
+    CompactListIterator operator--(int)
+    {
+        CompactListIterator temp = *this;
+        --*this;
+        return temp;
+    }
+
+    bool operator==(const CompactListIterator &other) const
+    {
+        return index_ == other.index_ && storage_ == other.storage_;
+    }
+
+    bool operator!=(const CompactListIterator &other) const
+    {
+        return !(*this == other);
+    }
+
+private:
+    friend ListType;
+    friend class CompactListIterator<ListType, const Type>;
+
+private:
+    Storage *storage_;
+    Owner *list_;
+    uint32_t index_;
+};
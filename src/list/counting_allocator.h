@@ -0,0 +1,113 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+// Allocation totals shared by all copies of a CountingAllocator.
+struct AllocationStats
+{
+    std::atomic<size_t> allocations{0};
+    std::atomic<size_t> deallocations{0};
+    std::atomic<size_t> bytes_allocated{0};
+    std::atomic<size_t> bytes_deallocated{0};
+
+    size_t live_allocations() const noexcept
+    {
+        return allocations - deallocations;
+    }
+
+    size_t live_bytes() const noexcept
+    {
+        return bytes_allocated - bytes_deallocated;
+    }
+};
+
+// Allocator adaptor that forwards to Base and records every allocation in
+// a shared AllocationStats. Plugged into List it counts node allocations,
+// frees and bytes; copies of a container keep reporting to the same stats.
+template <typename Type, typename Base = std::allocator<Type>>
+class CountingAllocator
+{
+    using BaseTraits = std::allocator_traits<Base>;
+
+public:
+    using value_type = Type;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    using is_always_equal = std::false_type;
+
+    template <typename Other>
+    struct rebind
+    {
+        using other = CountingAllocator<Other, typename BaseTraits::template rebind_alloc<Other>>;
+    };
+
+public: // Special member functions
+    CountingAllocator() : stats_(std::make_shared<AllocationStats>())
+    {
+    }
+
+    explicit CountingAllocator(std::shared_ptr<AllocationStats> stats, const Base &base = Base())
+        : stats_(std::move(stats)), base_(base)
+    {
+    }
+
+    CountingAllocator(const CountingAllocator &other) noexcept = default;
+
+    template <typename Other, typename OtherBase>
+    CountingAllocator(const CountingAllocator<Other, OtherBase> &other)
+        : stats_(other.stats_), base_(other.base_)
+    {
+    }
+
+    CountingAllocator &operator=(const CountingAllocator &other) noexcept = default;
+
+public: // Allocation
+    Type *allocate(size_t n)
+    {
+        Type *pointer = BaseTraits::allocate(base_, n);
+
+        stats_->allocations.fetch_add(1, std::memory_order_relaxed);
+        stats_->bytes_allocated.fetch_add(n * sizeof(Type), std::memory_order_relaxed);
+
+        return pointer;
+    }
+
+    void deallocate(Type *pointer, size_t n) noexcept
+    {
+        stats_->deallocations.fetch_add(1, std::memory_order_relaxed);
+        stats_->bytes_deallocated.fetch_add(n * sizeof(Type), std::memory_order_relaxed);
+
+        BaseTraits::deallocate(base_, pointer, n);
+    }
+
+    CountingAllocator select_on_container_copy_construction() const
+    {
+        return CountingAllocator(stats_, BaseTraits::select_on_container_copy_construction(base_));
+    }
+
+    const std::shared_ptr<AllocationStats> &stats() const noexcept
+    {
+        return stats_;
+    }
+
+    bool operator==(const CountingAllocator &other) const noexcept
+    {
+        return stats_ == other.stats_ && base_ == other.base_;
+    }
+
+    bool operator!=(const CountingAllocator &other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+private:
+    template <typename, typename>
+    friend class CountingAllocator;
+
+    std::shared_ptr<AllocationStats> stats_;
+    Base base_;
+};
@@ -0,0 +1,502 @@
+#pragma once
+
+#include "chain_sort.h"
+#include "intrusive_list_iterator.h"
+
+#include <functional>
+#include <iterator>
+#include <utility>
+
+// Links embedded into the elements of an IntrusiveList. A copied object
+// starts unlinked, the links of the source stay where they are.
+class IntrusiveListHook
+{
+public:
+    IntrusiveListHook() = default;
+
+    IntrusiveListHook(const IntrusiveListHook &) noexcept
+    {
+    }
+
+    IntrusiveListHook &operator=(const IntrusiveListHook &) noexcept
+    {
+        return *this;
+    }
+
+    bool is_linked() const noexcept
+    {
+        return next_ != nullptr;
+    }
+
+private:
+    template <typename Type, IntrusiveListHook Type::*>
+    friend class IntrusiveList;
+    template <typename>
+    friend class ChainSort;
+    template <class, typename>
+    friend class IntrusiveListIterator;
+
+private:
+    IntrusiveListHook *prev_ = nullptr;
+    IntrusiveListHook *next_ = nullptr;
+};
+
+// Doubly linked list of objects owned elsewhere. Every element embeds an
+// IntrusiveListHook and is linked in place, so nothing is ever allocated
+// and iteration only touches the elements themselves. An object can be in
+// at most one list per hook and must outlive its membership; the list never
+// destroys elements, erasing or clearing only unlinks them.
+template <typename Type, IntrusiveListHook Type::*HookMember>
+class IntrusiveList
+{
+private:
+    using Hook = IntrusiveListHook;
+
+    using Iter = IntrusiveListIterator<IntrusiveList, Type>;
+    using ConstIter = IntrusiveListIterator<IntrusiveList, const Type>;
+    using ReverseIter = std::reverse_iterator<Iter>;
+    using ConstReverseIter = std::reverse_iterator<ConstIter>;
+
+public: // Member types
+    using value_type = Type;
+    using iterator = Iter;
+    using const_iterator = ConstIter;
+
+public: // Special member functions
+    IntrusiveList() noexcept
+    {
+        reset_head();
+    }
+
+    IntrusiveList(const IntrusiveList &) = delete;
+    IntrusiveList &operator=(const IntrusiveList &) = delete;
+
+    IntrusiveList(IntrusiveList &&other) noexcept : IntrusiveList()
+    {
+        swap(other);
+    }
+
+    IntrusiveList &operator=(IntrusiveList &&other) noexcept
+    {
+        if (this != &other)
+        {
+            clear();
+            swap(other);
+        }
+
+        return *this;
+    }
+
+    ~IntrusiveList()
+    {
+        clear();
+    }
+
+public: // Size-related methods
+    size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+public: // Member access methods
+    Type &front()
+    {
+        return *to_value(head_.next_);
+    }
+
+    const Type &front() const
+    {
+        return *to_value(head_.next_);
+    }
+
+    Type &back()
+    {
+        return *to_value(head_.prev_);
+    }
+
+    const Type &back() const
+    {
+        return *to_value(head_.prev_);
+    }
+
+public: // Modifying methods
+    void push_front(Type &value) noexcept
+    {
+        link_before(head_.next_, to_hook(value));
+    }
+
+    void push_back(Type &value) noexcept
+    {
+        link_before(&head_, to_hook(value));
+    }
+
+    void pop_front() noexcept
+    {
+        unlink(head_.next_);
+    }
+
+    void pop_back() noexcept
+    {
+        unlink(head_.prev_);
+    }
+
+    void clear() noexcept
+    {
+        Hook *hook = head_.next_;
+
+        while (hook != &head_)
+        {
+            Hook *next = hook->next_;
+            hook->prev_ = hook->next_ = nullptr;
+            hook = next;
+        }
+
+        reset_head();
+    }
+
+    void swap(IntrusiveList &other) noexcept
+    {
+        std::swap(head_.prev_, other.head_.prev_);
+        std::swap(head_.next_, other.head_.next_);
+        std::swap(size_, other.size_);
+
+        fix_head();
+        other.fix_head();
+    }
+
+public: // Algorithms
+    void sort()
+    {
+        sort(std::less<Type>());
+    }
+
+    // Stable natural merge sort that only relinks elements, the same one
+    // List uses. If compare throws, all elements are kept but their order is
+    // unspecified.
+    template <typename CmpFunc>
+    void sort(CmpFunc compare)
+    {
+        if (size_ < 2)
+            return;
+
+        typename ChainSort<Hook>::Run sorted{head_.next_, head_.prev_, size_};
+        sorted.tail_->next_ = nullptr;
+
+        auto precedes = [&compare](const Hook *lhs, const Hook *rhs) { return compare(*to_value(lhs), *to_value(rhs)); };
+
+        try
+        {
+            ChainSort<Hook>::sort(sorted, precedes);
+        }
+        catch (...)
+        {
+            Hook *prev = &head_;
+
+            for (Hook *hook = sorted.head_; hook != nullptr; hook = hook->next_)
+            {
+                hook->prev_ = prev;
+                prev->next_ = hook;
+                prev = hook;
+            }
+
+            prev->next_ = &head_;
+            head_.prev_ = prev;
+            throw;
+        }
+
+        head_.next_ = sorted.head_;
+        head_.prev_ = sorted.tail_;
+        fix_head();
+    }
+
+    void merge(IntrusiveList &other)
+    {
+        merge(other, std::less<Type>());
+    }
+
+    template <typename CmpFunc>
+    void merge(IntrusiveList &other, CmpFunc compare)
+    {
+        if (this == &other)
+            return;
+
+        Hook *position = head_.next_;
+
+        while (!other.empty())
+        {
+            Hook *first = other.head_.next_;
+
+            while (position != &head_ && !compare(*to_value(first), *to_value(position)))
+                position = position->next_;
+
+            if (position == &head_)
+                break;
+
+            Hook *last = first;
+            size_t distance = 1;
+
+            for (; last->next_ != &other.head_ && compare(*to_value(last->next_), *to_value(position)); ++distance)
+                last = last->next_;
+
+            splice_internal(position, other, first, last, distance);
+        }
+
+        splice(cend(), other);
+    }
+
+    void splice(ConstIter position, IntrusiveList &other) noexcept
+    {
+        if (this == &other || other.empty())
+            return;
+
+        splice_internal(position.get_hook(), other, other.head_.next_, other.head_.prev_, other.size_);
+    }
+
+    void splice(ConstIter position, IntrusiveList &other, ConstIter begin, ConstIter end) noexcept
+    {
+        if (begin == end)
+            return;
+
+        Hook *first = begin.get_hook();
+        Hook *last = end.get_hook()->prev_;
+        size_t distance = this == &other ? 0 : count_hooks(first, last);
+
+        splice_internal(position.get_hook(), other, first, last, distance);
+    }
+
+    // Range splice for callers that already know std::distance(begin, end).
+    void splice(ConstIter position, IntrusiveList &other, ConstIter begin, ConstIter end, size_t distance) noexcept
+    {
+        if (begin == end)
+            return;
+
+        splice_internal(position.get_hook(), other, begin.get_hook(), end.get_hook()->prev_, distance);
+    }
+
+    void splice(ConstIter position, IntrusiveList &other, ConstIter it) noexcept
+    {
+        Hook *hook = it.get_hook();
+
+        if (position.get_hook() == hook || position.get_hook() == hook->next_)
+            return;
+
+        splice_internal(position.get_hook(), other, hook, hook, 1);
+    }
+
+    void reverse() noexcept
+    {
+        Hook *hook = &head_;
+
+        do
+        {
+            std::swap(hook->prev_, hook->next_);
+            hook = hook->prev_;
+        } while (hook != &head_);
+    }
+
+public: // Iterator-related methods
+    Iter insert(ConstIter position, Type &value) noexcept
+    {
+        Hook *hook = to_hook(value);
+
+        link_before(position.get_hook(), hook);
+
+        return Iter(hook);
+    }
+
+    Iter erase(ConstIter position) noexcept
+    {
+        Hook *next = position.get_hook()->next_;
+
+        unlink(position.get_hook());
+
+        return Iter(next);
+    }
+
+    Iter erase(ConstIter first, ConstIter last) noexcept
+    {
+        while (first != last)
+            first = erase(first);
+
+        return Iter(last.get_hook());
+    }
+
+    // Iterator to an element that is known to be in this list.
+    Iter iterator_to(Type &value) noexcept
+    {
+        return Iter(to_hook(value));
+    }
+
+    ConstIter iterator_to(const Type &value) const noexcept
+    {
+        return ConstIter(&(value.*HookMember));
+    }
+
+public: // Fabric methods
+    Iter begin() noexcept
+    {
+        return Iter(head_.next_);
+    }
+
+    Iter end() noexcept
+    {
+        return Iter(&head_);
+    }
+
+    ConstIter begin() const noexcept
+    {
+        return cbegin();
+    }
+
+    ConstIter end() const noexcept
+    {
+        return cend();
+    }
+
+    ConstIter cbegin() const noexcept
+    {
+        return ConstIter(head_.next_);
+    }
+
+    ConstIter cend() const noexcept
+    {
+        return ConstIter(&head_);
+    }
+
+    ReverseIter rbegin() noexcept
+    {
+        return ReverseIter(end());
+    }
+
+    ReverseIter rend() noexcept
+    {
+        return ReverseIter(begin());
+    }
+
+    ConstReverseIter crbegin() const noexcept
+    {
+        return ConstReverseIter(cend());
+    }
+
+    ConstReverseIter crend() const noexcept
+    {
+        return ConstReverseIter(cbegin());
+    }
+
+private: // Internal logic
+    static Hook *to_hook(Type &value) noexcept
+    {
+        return &(value.*HookMember);
+    }
+
+    static Type *to_value(Hook *hook) noexcept
+    {
+        return reinterpret_cast<Type *>(reinterpret_cast<char *>(hook) - hook_offset());
+    }
+
+    static const Type *to_value(const Hook *hook) noexcept
+    {
+        return reinterpret_cast<const Type *>(reinterpret_cast<const char *>(hook) - hook_offset());
+    }
+
+    // offsetof() only works for standard layout types, so the offset is
+    // taken from the storage of an object that is never constructed.
+    static std::ptrdiff_t hook_offset() noexcept
+    {
+        union Probe
+        {
+            Probe()
+            {
+            }
+
+            ~Probe()
+            {
+            }
+
+            Type value_;
+        };
+
+        Probe probe;
+
+        return reinterpret_cast<const char *>(&(probe.value_.*HookMember)) -
+               reinterpret_cast<const char *>(&probe.value_);
+    }
+
+    void reset_head() noexcept
+    {
+        head_.prev_ = head_.next_ = &head_;
+        size_ = 0;
+    }
+
+    void fix_head() noexcept
+    {
+        if (size_ == 0)
+        {
+            head_.prev_ = head_.next_ = &head_;
+            return;
+        }
+
+        head_.next_->prev_ = &head_;
+        head_.prev_->next_ = &head_;
+    }
+
+    void link_before(Hook *position, Hook *hook) noexcept
+    {
+        hook->prev_ = position->prev_;
+        hook->next_ = position;
+        position->prev_->next_ = hook;
+        position->prev_ = hook;
+
+        ++size_;
+    }
+
+    void unlink(Hook *hook) noexcept
+    {
+        hook->prev_->next_ = hook->next_;
+        hook->next_->prev_ = hook->prev_;
+        hook->prev_ = hook->next_ = nullptr;
+
+        --size_;
+    }
+
+    // Moves [first, last] of other in front of position.
+    void splice_internal(Hook *position, IntrusiveList &other, Hook *first, Hook *last, size_t distance) noexcept
+    {
+        first->prev_->next_ = last->next_;
+        last->next_->prev_ = first->prev_;
+
+        first->prev_ = position->prev_;
+        last->next_ = position;
+        position->prev_->next_ = first;
+        position->prev_ = last;
+
+        if (this != &other)
+        {
+            other.size_ -= distance;
+            size_ += distance;
+        }
+    }
+
+    static size_t count_hooks(const Hook *first, const Hook *last) noexcept
+    {
+        size_t count = 1;
+
+        for (; first != last; first = first->next_)
+            ++count;
+
+        return count;
+    }
+
+private:
+    template <class, typename>
+    friend class IntrusiveListIterator;
+
+private:
+    Hook head_;
+    size_t size_ = 0;
+};
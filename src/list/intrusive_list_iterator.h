@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+class IntrusiveListHook;
+
+template <class ListType, typename Type>
+class IntrusiveListIterator
+{
+public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = std::remove_const_t<Type>;
+    using pointer = Type *;
+    using reference = Type &;
+    using difference_type = std::ptrdiff_t;
+
+private:
+    using DeConstedType = std::remove_const_t<Type>;
+    using DeConstedIter = IntrusiveListIterator<ListType, DeConstedType>;
+    using Hook = std::conditional_t<std::is_const_v<Type>, const IntrusiveListHook, IntrusiveListHook>;
+
+public:
+    IntrusiveListIterator(Hook *hook) : hook_(hook)
+    {
+    }
+
+    IntrusiveListIterator(const IntrusiveListIterator &other) = default;
+
+    template <typename OtherIter,
+              typename = std::enable_if_t<std::is_const_v<Type> && std::is_same_v<OtherIter, DeConstedIter>>>
+    IntrusiveListIterator(const OtherIter &other) : hook_(other.hook_)
+    {
+    }
+
+    IntrusiveListIterator &operator=(const IntrusiveListIterator &other) = default;
+
+    reference operator*() const
+    {
+        return *ListType::to_value(hook_);
+    }
+
+    pointer operator->() const
+    {
+        return ListType::to_value(hook_);
+    }
+
+    IntrusiveListIterator &operator++()
+    {
+        hook_ = hook_->next_;
+        return *this;
+    }
+
+    IntrusiveListIterator operator++(int)
+    {
+        IntrusiveListIterator temp = *this;
+        hook_ = hook_->next_;
+        return temp;
+    }
+
+    IntrusiveListIterator &operator--()
+    {
+        hook_ = hook_->prev_;
+        return *this;
+    }
+
+    IntrusiveListIterator operator--(int)
+    {
+        IntrusiveListIterator temp = *this;
+        hook_ = hook_->prev_;
+        return temp;
+    }
+
+    bool operator==(const IntrusiveListIterator &other) const
+    {
+        return hook_ == other.hook_;
+    }
+
+    bool operator!=(const IntrusiveListIterator &other) const
+    {
+        return !(*this == other);
+    }
+
+private:
+    IntrusiveListHook *get_hook() const noexcept
+    {
+        return const_cast<IntrusiveListHook *>(hook_);
+    }
+
+private:
+    friend ListType;
+    friend class IntrusiveListIterator<ListType, const Type>;
+
+private:
+    Hook *hook_;
+};
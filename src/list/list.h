@@ -1,11 +1,31 @@
 #pragma once
 
+#include "chain_sort.h"
 #include "list_iterator.h"
+#include "prefetch.h"
+#include "radix_sort.h"
+
+#include <thread_pool/thread_pool.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 template <class NodeType, typename Type>
 class ListIterator;
 
-template <typename Type>
+template <typename Type, typename Allocator = std::allocator<Type>>
 class List
 {
 private:
@@ -33,62 +53,182 @@ private:
     using ReverseIter = std::reverse_iterator<Iter>;
     using ConstReverseIter = std::reverse_iterator<ConstIter>;
 
+    using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using NodeAllocTraits = std::allocator_traits<NodeAllocator>;
+
+    // Owns a node taken out of a list by extract(). The node keeps its
+    // value and memory until it is inserted into a list with an equal
+    // allocator, or is freed with the handle.
+    class NodeHandle
+    {
+    public:
+        NodeHandle() = default;
+
+        NodeHandle(NodeHandle &&other) noexcept
+            : node_(std::exchange(other.node_, nullptr)), allocator_(std::move(other.allocator_))
+        {
+        }
+
+        NodeHandle &operator=(NodeHandle &&other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+                node_ = std::exchange(other.node_, nullptr);
+                allocator_ = std::move(other.allocator_);
+            }
+
+            return *this;
+        }
+
+        ~NodeHandle()
+        {
+            reset();
+        }
+
+        bool empty() const noexcept
+        {
+            return node_ == nullptr;
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return node_ != nullptr;
+        }
+
+        Type &value() const noexcept
+        {
+            return node_->value_;
+        }
+
+        Allocator get_allocator() const
+        {
+            return Allocator(*allocator_);
+        }
+
+    private:
+        NodeHandle(Node *node, const NodeAllocator &allocator) : node_(node), allocator_(allocator)
+        {
+        }
+
+        Node *release() noexcept
+        {
+            return std::exchange(node_, nullptr);
+        }
+
+        void reset() noexcept
+        {
+            if (node_ == nullptr)
+                return;
+
+            NodeAllocTraits::destroy(*allocator_, node_);
+            NodeAllocTraits::deallocate(*allocator_, node_, 1);
+            node_ = nullptr;
+        }
+
+    private:
+        friend class List;
+
+    private:
+        Node *node_ = nullptr;
+        std::optional<NodeAllocator> allocator_;
+    };
+
+public: // Member types
+    using value_type = Type;
+    using allocator_type = Allocator;
+    using iterator = Iter;
+    using const_iterator = ConstIter;
+    using node_type = NodeHandle;
+
 public: // Special member functions
     List() = default;
 
-    List(const Type &value) : first_(new Node(value)), end_(first_)
+    explicit List(const Allocator &allocator) : allocator_(allocator)
+    {
+    }
+
+    List(const Type &value)
     {
+        emplace_back(value);
     }
 
-    List(Type &&value) : first_(new Node(std::forward<Type>(value))), end_(first_)
+    List(Type &&value)
     {
+        emplace_back(std::move(value));
     }
 
     List(std::initializer_list<Type> values)
     {
-        for (const Type &val : values)
-            emplace_back(val);
+        insert_chain(end_node(), create_chain(values.begin(), values.end()));
     }
 
     template <typename _InputIterator,
               typename = std::_RequireInputIter<_InputIterator>>
     List(_InputIterator first, _InputIterator last)
     {
-        while (first != last)
-        {
-            emplace_back(*first);
-            ++first;
-        }
+        insert_chain(end_node(), create_chain(first, last));
     }
 
     List(const List &other)
+        : allocator_(NodeAllocTraits::select_on_container_copy_construction(other.allocator_))
     {
-        Node *element = other.first_;
-
-        while (element != other.end_node())
-        {
-            emplace_back(element->value_);
-            element = element->next_;
-        }
+        insert_chain(end_node(), create_chain(other.begin(), other.end()));
     }
 
-    List(List &&other) noexcept
+    List(List &&other) noexcept : allocator_(other.allocator_)
     {
-        swap(other);
+        swap_links(other);
     }
 
+    // Reuses the nodes this list already has, see assign().
     List &operator=(const List &other)
     {
-        if (this != &other)
-            List(other).swap(*this);
+        if (this == &other)
+            return *this;
+
+        if constexpr (NodeAllocTraits::propagate_on_container_copy_assignment::value)
+        {
+            if (allocator_ != other.allocator_)
+                clear();
+
+            allocator_ = other.allocator_;
+        }
+
+        assign_internal(other.begin(), other.end());
 
         return *this;
     }
 
-    List &operator=(List &&other) noexcept
+    // Steals the nodes when the allocator propagates or both allocators
+    // are equal, otherwise the values are moved over one by one.
+    List &operator=(List &&other) noexcept(
+        NodeAllocTraits::propagate_on_container_move_assignment::value ||
+        NodeAllocTraits::is_always_equal::value)
     {
-        if (this != &other)
-            List(std::move(other)).swap(*this);
+        if (this == &other)
+            return *this;
+
+        if constexpr (NodeAllocTraits::propagate_on_container_move_assignment::value)
+        {
+            clear();
+            allocator_ = std::move(other.allocator_);
+            swap_links(other);
+        }
+        else
+        {
+            if (allocator_ == other.allocator_)
+            {
+                clear();
+                swap_links(other);
+            }
+            else
+            {
+                assign_internal(std::make_move_iterator(other.begin()),
+                                std::make_move_iterator(other.end()));
+                other.clear();
+            }
+        }
 
         return *this;
     }
@@ -109,6 +249,11 @@ public: // Size-related methods
         return size_ == 0;
     }
 
+    Allocator get_allocator() const noexcept
+    {
+        return Allocator(allocator_);
+    }
+
 public: // Member access methods
     Type &front() noexcept
     {
@@ -163,6 +308,16 @@ public: // Modifying methods
         create_node(end_node(), std::forward<Types>(args)...);
     }
 
+    void push_front(NodeHandle &&handle) noexcept
+    {
+        insert(cbegin(), std::move(handle));
+    }
+
+    void push_back(NodeHandle &&handle) noexcept
+    {
+        insert(cend(), std::move(handle));
+    }
+
     void pop_front() noexcept
     {
         first_ = erase_node(first_);
@@ -177,24 +332,21 @@ public: // Modifying methods
 
     void swap(List &other) noexcept
     {
-        if (empty())
-            first_ = other.end_node();
-        else
-            end_node()->prev_->next_ = other.end_node();
-
-        if (other.empty())
-            other.first_ = end_node();
-        else
-            other.end_node()->prev_->next_ = end_node();
+        if constexpr (NodeAllocTraits::propagate_on_container_swap::value)
+            std::swap(allocator_, other.allocator_);
 
-        std::swap(size_, other.size_);
-        std::swap(first_, other.first_);
-        std::swap(end_, other.end_);
+        swap_links(other);
     }
 
     void clear() noexcept
     {
-        erase_nodes(first_, end_node()->prev_);
+        invalidate_index();
+        finger_ = nullptr;
+        destroy_nodes(first_, end_node());
+
+        first_ = end_node();
+        end_.prev_ = nullptr;
+        size_ = 0;
     }
 
     void resize(size_t new_size)
@@ -207,25 +359,33 @@ public: // Modifying methods
         resize_internal(new_size, value);
     }
 
+    // Assignment overwrites the values of the existing nodes in place and
+    // only allocates or frees the difference in length. If assigning a
+    // value or allocating throws, the list stays valid but may hold a mix of
+    // old and new values (basic guarantee).
     void assign(std::initializer_list<Type> values)
     {
-        clear();
-
-        for (const auto &val : values)
-            emplace_back(val);
+        assign_internal(values.begin(), values.end());
     }
 
     template <typename _InputIterator,
               typename = std::_RequireInputIter<_InputIterator>>
     void assign(_InputIterator first, _InputIterator last)
     {
-        clear();
+        assign_internal(first, last);
+    }
 
-        while (first != last)
-        {
-            emplace_back(*first);
-            ++first;
-        }
+    void assign(size_t count, const Type &value)
+    {
+        Node *node = first_;
+
+        for (; node != end_node() && count != 0; node = node->next_, --count)
+            node->value_ = value;
+
+        if (count != 0)
+            insert_chain(end_node(), create_chain_n(count, value));
+        else
+            erase_nodes(node, end_.prev_);
     }
 
 public: // Algorithms
@@ -234,44 +394,314 @@ public: // Algorithms
         sort(std::less<Type>());
     }
 
+    // Natural merge sort on the raw node chain: already ordered runs are
+    // picked up as they are, so nearly sorted input costs close to O(n), and
+    // no size bookkeeping happens along the way. If compare throws, all
+    // elements are kept but their order is unspecified. Arithmetic lists
+    // sorted with std::less or std::greater take the radix path of
+    // sort_by_key instead, unless they are short or its buffers can't be
+    // allocated.
     template <typename CmpFunc>
     void sort(CmpFunc compare)
     {
-        if (first_ == end_node() && first_->next_ == end_node())
+        if (size_ < 2)
+            return;
+
+        if constexpr (is_radix_sortable_v<Type> &&
+                      (is_ascending_order_v<CmpFunc, Type> || is_descending_order_v<CmpFunc, Type>))
+        {
+            constexpr size_t radix_threshold = 128;
+
+            if (size_ >= radix_threshold)
+            {
+                try
+                {
+                    sort_by_key([](Type value) { return value; }, compare);
+                    return;
+                }
+                catch (const std::bad_alloc &)
+                {
+                }
+            }
+        }
+
+        Run sorted{first_, end_.prev_, size_};
+        sorted.tail_->next_ = nullptr;
+
+        try
+        {
+            sort_chain(sorted, compare);
+        }
+        catch (...)
+        {
+            relink_chain(sorted.head_);
+            throw;
+        }
+
+        attach_run(sorted);
+    }
+
+    template <typename Projection>
+    void sort_by_key(Projection projection)
+    {
+        sort_by_key(projection, std::less<>());
+    }
+
+    // Projects every element once into a side array of (key, node) pairs,
+    // sorts that array and relinks the nodes in its order, so no element is
+    // moved. Arithmetic keys ordered by std::less or std::greater are radix
+    // sorted, any other keys are stable sorted with compare. The list is left
+    // untouched if projection or compare throws.
+    template <typename Projection, typename CmpFunc>
+    void sort_by_key(Projection projection, CmpFunc compare)
+    {
+        using Key = std::decay_t<std::invoke_result_t<Projection &, const Type &>>;
+
+        if (size_ < 2)
+            return;
+
+        if constexpr (is_radix_sortable_v<Key> &&
+                      (is_ascending_order_v<CmpFunc, Key> || is_descending_order_v<CmpFunc, Key>))
+        {
+            std::vector<std::pair<RadixKey<Key>, Node *>> items;
+            items.reserve(size_);
+
+            for (Node *node = first_; node != end_node(); node = node->next_)
+                items.emplace_back(to_radix_key<Key>(std::invoke(projection, std::as_const(node->value_)),
+                                                     is_descending_order_v<CmpFunc, Key>),
+                                   node);
+
+            radix_sort(items);
+            relink_sorted(items);
+        }
+        else
+        {
+            std::vector<std::pair<Key, Node *>> items;
+            items.reserve(size_);
+
+            for (Node *node = first_; node != end_node(); node = node->next_)
+                items.emplace_back(std::invoke(projection, std::as_const(node->value_)), node);
+
+            std::stable_sort(items.begin(), items.end(),
+                             [&compare](const auto &lhs, const auto &rhs) { return compare(lhs.first, rhs.first); });
+
+            relink_sorted(items);
+        }
+    }
+
+    void parallel_sort(size_t threads = std::thread::hardware_concurrency())
+    {
+        parallel_sort(std::less<Type>(), threads);
+    }
+
+    // Cuts the chain into one segment per thread, sorts the segments
+    // concurrently and merges them pairwise, with one thread merging each
+    // pair from the front and another from the back. Nodes are relinked in
+    // place and no element is copied. compare is copied into every task,
+    // which run in the shared pool.
+    template <typename CmpFunc,
+              typename = std::enable_if_t<std::is_invocable_r_v<bool, CmpFunc &, const Type &, const Type &>>>
+    void parallel_sort(CmpFunc compare, size_t threads = std::thread::hardware_concurrency())
+    {
+        constexpr size_t min_segment_size = 1 << 14;
+
+        size_t segments = std::min(threads, size_ / min_segment_size);
+
+        if (segments < 2)
+        {
+            sort(compare);
             return;
+        }
+
+        std::vector<Run> runs = split_into_runs(segments);
+        ThreadPool &pool = ThreadPool::shared();
+
+        std::vector<std::future<void>> tasks;
+        std::exception_ptr error;
+
+        // Tasks refer to runs and halves, so a failed submission waits for
+        // the submitted ones before the list is relinked.
+        try
+        {
+            tasks.reserve(runs.size());
+
+            for (Run &run : runs)
+                tasks.push_back(pool.submit([&run, compare]() mutable { sort_chain(run, compare); }));
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
 
-        List carry;
-        List tmp[64];
-        List *fill = tmp;
-        List *counter;
+        if (std::exception_ptr task_error = wait_for(pool, tasks); !error)
+            error = task_error;
+
+        if (error)
+        {
+            relink_runs(runs);
+            std::rethrow_exception(error);
+        }
 
-        do
+        while (runs.size() > 1)
         {
-            carry.splice(carry.begin(), *this, begin());
+            size_t pairs = runs.size() / 2;
+            std::vector<HalfMerge> halves;
+            std::vector<Run> merged;
+
+            try
+            {
+                halves.reserve(2 * pairs);
+                merged.reserve(pairs + 1);
+
+                for (size_t i = 0; i < pairs; ++i)
+                {
+                    halves.push_back(HalfMerge{runs[2 * i].head_, runs[2 * i + 1].head_});
+                    halves.push_back(HalfMerge{runs[2 * i].tail_, runs[2 * i + 1].tail_});
+                }
+            }
+            catch (...)
+            {
+                relink_runs(runs);
+                throw;
+            }
+
+            try
+            {
+                for (size_t i = 0; i < pairs; ++i)
+                {
+                    const Run &lhs = runs[2 * i];
+                    const Run &rhs = runs[2 * i + 1];
+                    size_t front_count = (lhs.length_ + rhs.length_) / 2;
+
+                    HalfMerge &front = halves[2 * i];
+                    HalfMerge &back = halves[2 * i + 1];
+
+                    tasks.push_back(pool.submit([&front, &lhs, &rhs, front_count, compare]() mutable
+                                                { merge_front(front, lhs, rhs, front_count, compare); }));
+                    tasks.push_back(pool.submit([&back, &lhs, &rhs, front_count, compare]() mutable
+                                                { merge_back(back, lhs, rhs, lhs.length_ + rhs.length_ - front_count, compare); }));
+                }
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+
+            if (std::exception_ptr task_error = wait_for(pool, tasks); !error)
+                error = task_error;
 
-            for (counter = tmp; counter != fill && !counter->empty(); ++counter)
+            for (size_t i = 0; i < pairs; ++i)
             {
-                ++count;
-                counter->merge(carry, compare);
-                carry.swap(*counter);
+                const Run &lhs = runs[2 * i];
+                const Run &rhs = runs[2 * i + 1];
+
+                if (error)
+                    merged.push_back(Run{recover_halves(halves[2 * i], halves[2 * i + 1], lhs, rhs)});
+                else
+                    merged.push_back(join_halves(halves[2 * i], halves[2 * i + 1], lhs.length_ + rhs.length_));
+            }
+
+            if (runs.size() % 2 != 0)
+                merged.push_back(runs.back());
+
+            runs = std::move(merged);
+
+            if (error)
+            {
+                relink_runs(runs);
+                std::rethrow_exception(error);
             }
-            carry.swap(*counter);
-            if (counter == fill)
-                ++fill;
-        } while (!empty());
+        }
+
+        attach_run(runs.front());
+    }
+
+    // Calls func on every element from several threads at once, so func
+    // has to be safe to call concurrently. Runs serially on short lists.
+    template <typename Func>
+    void parallel_for_each(Func func, size_t threads = std::thread::hardware_concurrency())
+    {
+        run_segments(threads,
+                     [&func](size_t, const Node *node, size_t length)
+                     {
+                         for (; length != 0; --length, node = node->next_)
+                             func(const_cast<Node *>(node)->value_);
+                     });
+    }
+
+    // Folds every segment on its own and combines the partial results in
+    // list order, so op has to be associative but not commutative. Like
+    // std::reduce, op combines elements as well as partial results and each
+    // segment starts from its first element, so elements have to convert
+    // to Result. init is used once. For folds that don't fit this, use the
+    // overload with a separate combine.
+    template <typename Result, typename BinaryOp>
+    Result parallel_reduce(Result init, BinaryOp op, size_t threads = std::thread::hardware_concurrency()) const
+    {
+        std::vector<std::optional<Result>> partials(segment_count(threads));
+
+        run_segments(threads,
+                     [&partials, &op](size_t index, const Node *node, size_t length)
+                     {
+                         Result partial = node->value_;
+
+                         for (node = node->next_; --length != 0; node = node->next_)
+                             partial = op(std::move(partial), node->value_);
 
-        for (counter = tmp + 1; counter != fill; ++counter)
-            counter->merge(*(counter - 1), compare);
-        swap(*(fill - 1));
+                         partials[index].emplace(std::move(partial));
+                     });
 
+        return combine_partials(std::move(init), partials, op);
+    }
+
+    // Folds every segment with fold(Result, const Type &) starting from a
+    // copy of init and combines the partial results with
+    // combine(Result, Result) in list order. init seeds every segment, so it
+    // has to be an identity of combine, e.g. 0 for a count.
+    template <typename Result, typename FoldOp, typename CombineOp,
+              typename = std::enable_if_t<std::is_invocable_v<CombineOp &, Result, Result>>>
+    Result parallel_reduce(Result init, FoldOp fold, CombineOp combine,
+                           size_t threads = std::thread::hardware_concurrency()) const
+    {
+        std::vector<std::optional<Result>> partials(segment_count(threads));
+
+        run_segments(threads,
+                     [&partials, &init, &fold](size_t index, const Node *node, size_t length)
+                     {
+                         Result partial = init;
+
+                         for (; length != 0; --length, node = node->next_)
+                             partial = fold(std::move(partial), node->value_);
+
+                         partials[index].emplace(std::move(partial));
+                     });
+
+        return combine_partials(std::move(init), partials, combine);
     }
 
     void splice(ConstIter position, List &other)
     {
-        splice(position.get_node(), other, other.begin(), other.end());
+        if (this == &other || other.empty())
+            return;
+
+        splice_internal(position.get_node(), other, other.first_, other.end_.prev_, other.size_);
     }
 
     void splice(ConstIter position, List &other, ConstIter begin, ConstIter end)
+    {
+        if (begin == end)
+            return;
+
+        Node *first = begin.get_node();
+        Node *last = end.get_node()->prev_;
+        size_t distance = this == &other ? 0 : count_nodes(first, last);
+
+        splice_internal(position.get_node(), other, first, last, distance);
+    }
+
+    // Range splice for callers that already know std::distance(begin, end),
+    // which saves walking the range to keep both sizes up to date.
+    void splice(ConstIter position, List &other, ConstIter begin, ConstIter end, size_t distance)
     {
         if (begin == end)
             return;
@@ -279,12 +709,17 @@ public: // Algorithms
         Node *first = begin.get_node();
         Node *last = end.get_node()->prev_;
 
-        splice_internal(position.get_node(), other, first, last);
+        splice_internal(position.get_node(), other, first, last, distance);
     }
 
     void splice(ConstIter position, List &other, ConstIter it)
     {
-        splice_internal(position.get_node(), other, it.get_node(), it.get_node());
+        Node *node = it.get_node();
+
+        if (position.get_node() == node || position.get_node() == node->next_)
+            return;
+
+        splice_internal(position.get_node(), other, node, node, 1);
     }
 
     void reverse()
@@ -292,6 +727,8 @@ public: // Algorithms
         if (first_ == end_node())
             return;
 
+        invalidate_index();
+
         Node *node = first_;
         while (node != end_node())
         {
@@ -312,86 +749,321 @@ public: // Algorithms
     template <typename CmpFunc>
     void merge(List &other, CmpFunc compare)
     {
-        Iter pos = begin();
+        if (this == &other)
+            return;
 
-        Iter last = other.begin();
-        Iter first = last++;
+        Iter pos = begin();
+        Iter first = other.begin();
 
-        while (true)
+        while (first != other.end())
         {
-            while (compare(*pos, *first) && pos != end())
+            while (pos != end() && !compare(*first, *pos))
                 ++pos;
 
             if (pos == end())
                 break;
 
-            while (last != other.end() && compare(*last, *pos))
-                ++last;
+            Iter last = std::next(first);
+            size_t distance = 1;
 
-            if (last == other.end())
-                break;
+            for (; last != other.end() && compare(*last, *pos); ++last)
+                ++distance;
 
-            splice(pos, other, first, last);
+            splice(pos, other, first, last, distance);
 
-            first = last++;
+            first = last;
         }
 
-        splice(pos, other, first, other.end());
+        splice(end(), other, first, other.end(), other.size_);
     }
 
-public: // Iterator-related methods
-    Iter erase(Iter it)
+    // value may refer to an element of the list, the node holding it is
+    // erased last.
+    size_t remove(const Type &value)
     {
-        return Iter(erase_node(it.get_node()));
+        Node *aliased = nullptr;
+
+        size_t count = erase_nodes_if(first_, [&value, &aliased](Node *node) {
+            if (!(node->value_ == value))
+                return false;
+
+            if (std::addressof(node->value_) == std::addressof(value))
+            {
+                aliased = node;
+                return false;
+            }
+
+            return true;
+        });
+
+        if (aliased != nullptr)
+        {
+            erase_node(aliased);
+            ++count;
+        }
+
+        return count;
     }
 
-    ReverseIter erase(ReverseIter it)
+    template <typename Predicate>
+    size_t remove_if(Predicate predicate)
     {
-        return ReverseIter(erase_node((--it.base()).element_));
+        return erase_nodes_if(first_, [&predicate](Node *node) { return predicate(node->value_); });
     }
 
-    Iter insert(Iter it, Type val)
+    size_t unique()
     {
-        return Iter(create_node(it.get_node(), std::move(val)));
+        return unique(std::equal_to<Type>());
     }
 
-    ReverseIter insert(const ReverseIter it)
+    // Keeps the first element of every run of equal ones.
+    template <typename BinaryPredicate>
+    size_t unique(BinaryPredicate equal)
     {
-        return ReverseIter(create_node((--it.base()).element_));
+        if (empty())
+            return 0;
+
+        Node *kept = first_;
+
+        return erase_nodes_if(first_->next_, [&equal, &kept](Node *node) {
+            if (equal(kept->value_, node->value_))
+                return true;
+
+            kept = node;
+            return false;
+        });
     }
 
-public: // Fabric methods
-    Iter begin() noexcept
+public: // Iterator-related methods
+    Iter erase(ConstIter it)
     {
-        return Iter(first_);
+        return Iter(erase_node(it.get_node()));
     }
 
-    Iter end() noexcept
+    ReverseIter erase(ReverseIter it)
     {
-        return Iter(end_node());
+        return ReverseIter(erase_node((--it.base()).element_));
     }
 
-    ConstIter begin() const noexcept
+    Iter insert(Iter it, Type val)
     {
-        return ConstIter(first_);
+        return Iter(create_node(it.get_node(), std::move(val)));
     }
 
-    ConstIter end() const noexcept
+    Iter insert(ConstIter it, size_t count, const Type &value)
     {
-        return ConstIter(end_node());
+        return insert_chain_at(it.get_node(), create_chain_n(count, value));
     }
 
-    ConstIter cbegin() const noexcept
+    template <typename _InputIterator,
+              typename = std::_RequireInputIter<_InputIterator>>
+    Iter insert(ConstIter it, _InputIterator first, _InputIterator last)
     {
-        return ConstIter(first_);
+        return insert_chain_at(it.get_node(), create_chain(first, last));
     }
 
-    ConstIter cend() const noexcept
+    Iter insert(ConstIter it, std::initializer_list<Type> values)
     {
-        return ConstIter(end_node());
+        return insert_chain_at(it.get_node(), create_chain(values.begin(), values.end()));
     }
 
-    ReverseIter rbegin() noexcept
+    // Unlinks the node without freeing it or touching the value.
+    NodeHandle extract(ConstIter it) noexcept
+    {
+        Node *node = it.get_node();
+
+        extract_nodes(node, node);
+        --size_;
+        node->prev_ = node->next_ = nullptr;
+
+        return NodeHandle(node, allocator_);
+    }
+
+    // Links the handle's node in before it. The handle must come from a list
+    // with an equal allocator; an empty handle inserts nothing.
+    Iter insert(ConstIter it, NodeHandle &&handle) noexcept
+    {
+        if (handle.empty())
+            return Iter(it.get_node());
+
+        Node *node = handle.release();
+
+        emplace_nodes(it.get_node(), node, node);
+        ++size_;
+
+        return Iter(node);
+    }
+
+    Iter erase(ConstIter first, ConstIter last)
+    {
+        if (first == last)
+            return Iter(last.get_node());
+
+        return Iter(erase_nodes(first.get_node(), last.get_node()->prev_));
+    }
+
+    template <typename... Types>
+    Iter emplace(ConstIter it, Types &&...args)
+    {
+        return Iter(create_node(it.get_node(), std::forward<Types>(args)...));
+    }
+
+    ReverseIter insert(const ReverseIter it)
+    {
+        return ReverseIter(create_node((--it.base()).element_));
+    }
+
+public: // Sorted list methods
+    // Inserts value after the elements that don't order after it, keeping a
+    // list sorted by compare sorted. The search starts at the hint or, without
+    // one, at the previous insertion point (or the back) and walks in
+    // whichever direction value lies, so nearly ordered input inserts in
+    // about constant time. Long walks switch to the skip index when it is
+    // already built.
+    Iter insert_sorted(Type value)
+    {
+        return insert_sorted(std::move(value), std::less<Type>());
+    }
+
+    template <typename CmpFunc>
+    Iter insert_sorted(Type value, CmpFunc compare)
+    {
+        return insert_sorted_from(finger_ != nullptr ? finger_ : end_node(), std::move(value), compare);
+    }
+
+    Iter insert_sorted(ConstIter hint, Type value)
+    {
+        return insert_sorted(hint, std::move(value), std::less<Type>());
+    }
+
+    template <typename CmpFunc>
+    Iter insert_sorted(ConstIter hint, Type value, CmpFunc compare)
+    {
+        return insert_sorted_from(const_cast<Node *>(hint.get_node()), std::move(value), compare);
+    }
+
+    // Binary searches over the skip index, which the first call on a long
+    // list builds, and walks at most about one stride from there.
+    template <typename Key, typename CmpFunc = std::less<>>
+    Iter lower_bound(const Key &value, CmpFunc compare = CmpFunc())
+    {
+        return Iter(const_cast<Node *>(bound_node(value, compare, false)));
+    }
+
+    template <typename Key, typename CmpFunc = std::less<>>
+    ConstIter lower_bound(const Key &value, CmpFunc compare = CmpFunc()) const
+    {
+        return ConstIter(bound_node(value, compare, false));
+    }
+
+    template <typename Key, typename CmpFunc = std::less<>>
+    Iter upper_bound(const Key &value, CmpFunc compare = CmpFunc())
+    {
+        return Iter(const_cast<Node *>(bound_node(value, compare, true)));
+    }
+
+    template <typename Key, typename CmpFunc = std::less<>>
+    ConstIter upper_bound(const Key &value, CmpFunc compare = CmpFunc()) const
+    {
+        return ConstIter(bound_node(value, compare, true));
+    }
+
+    template <typename Key, typename CmpFunc = std::less<>>
+    std::pair<Iter, Iter> equal_range(const Key &value, CmpFunc compare = CmpFunc())
+    {
+        Iter first = lower_bound(value, compare);
+        Iter last = first;
+
+        while (last != end() && !compare(value, *last))
+            ++last;
+
+        return {first, last};
+    }
+
+    template <typename Key, typename CmpFunc = std::less<>>
+    std::pair<ConstIter, ConstIter> equal_range(const Key &value, CmpFunc compare = CmpFunc()) const
+    {
+        ConstIter first = lower_bound(value, compare);
+        ConstIter last = first;
+
+        while (last != end() && !compare(value, *last))
+            ++last;
+
+        return {first, last};
+    }
+
+public: // Positional access
+    // Positional lookups go through a sparse skip index that remembers every
+    // stride-th node, stride being about sqrt(size()). It is built by the
+    // first lookup and survives insertions and removals at either end;
+    // other structural changes drop it and the next lookup rebuilds it. A
+    // lookup walks at most about stride / 2 nodes. Because the index is
+    // built lazily, lookups must not run concurrently even on a const list.
+    Iter nth(size_t index)
+    {
+        return Iter(const_cast<Node *>(nth_node(index)));
+    }
+
+    ConstIter nth(size_t index) const
+    {
+        return ConstIter(nth_node(index));
+    }
+
+    size_t index_of(ConstIter it) const
+    {
+        return node_index(it.get_node());
+    }
+
+    // Same as std::next(it, distance) for distance in [-index_of(it),
+    // size() - index_of(it)], but long jumps use the skip index.
+    Iter advance(ConstIter it, std::ptrdiff_t distance)
+    {
+        Node *node = const_cast<Node *>(it.get_node());
+
+        if (static_cast<size_t>(std::abs(distance)) > skip_walk_limit)
+            return nth(node_index(node) + distance);
+
+        for (; distance > 0; --distance)
+            node = node->next_;
+
+        for (; distance < 0; ++distance)
+            node = node->prev_;
+
+        return Iter(node);
+    }
+
+public: // Fabric methods
+    Iter begin() noexcept
+    {
+        return Iter(first_);
+    }
+
+    Iter end() noexcept
+    {
+        return Iter(end_node());
+    }
+
+    ConstIter begin() const noexcept
+    {
+        return ConstIter(first_);
+    }
+
+    ConstIter end() const noexcept
+    {
+        return ConstIter(end_node());
+    }
+
+    ConstIter cbegin() const noexcept
+    {
+        return ConstIter(first_);
+    }
+
+    ConstIter cend() const noexcept
+    {
+        return ConstIter(end_node());
+    }
+
+    ReverseIter rbegin() noexcept
     {
         return ReverseIter(end());
     }
@@ -412,20 +1084,199 @@ public: // Fabric methods
     }
 
 private: // Internal logic
+    // Detached run of linked nodes that is built up front and then spliced
+    // into the list at once, so size_ and first_ are touched a single time.
+    struct Chain
+    {
+        Node *first_ = nullptr;
+        Node *last_ = nullptr;
+        size_t size_ = 0;
+    };
+
+    void append_to_chain(Chain &chain, Node *node) noexcept
+    {
+        node->prev_ = chain.last_;
+
+        if (chain.last_ != nullptr)
+            chain.last_->next_ = node;
+        else
+            chain.first_ = node;
+
+        chain.last_ = node;
+        ++chain.size_;
+    }
+
+    template <typename _InputIterator>
+    Chain create_chain(_InputIterator first, _InputIterator last)
+    {
+        Chain chain;
+
+        try
+        {
+            for (; first != last; ++first)
+                append_to_chain(chain, allocate_node(*first));
+        }
+        catch (...)
+        {
+            destroy_chain(chain);
+            throw;
+        }
+
+        return chain;
+    }
+
+    template <typename... Types>
+    Chain create_chain_n(size_t count, const Types &...args)
+    {
+        Chain chain;
+
+        try
+        {
+            while (chain.size_ != count)
+                append_to_chain(chain, allocate_node(args...));
+        }
+        catch (...)
+        {
+            destroy_chain(chain);
+            throw;
+        }
+
+        return chain;
+    }
+
+    void destroy_chain(Chain &chain) noexcept
+    {
+        destroy_nodes(chain.first_, nullptr);
+        chain = Chain();
+    }
+
+    void insert_chain(Node *position, const Chain &chain) noexcept
+    {
+        if (chain.size_ == 0)
+            return;
+
+        emplace_nodes(position, chain.first_, chain.last_);
+        size_ += chain.size_;
+    }
+
+    template <typename _InputIterator>
+    void assign_internal(_InputIterator first, _InputIterator last)
+    {
+        if constexpr (!std::is_assignable_v<Type &, decltype(*first)>)
+        {
+            Chain chain = create_chain(first, last);
+
+            clear();
+            insert_chain(end_node(), chain);
+        }
+        else
+        {
+            Node *node = first_;
+
+            for (; node != end_node() && first != last; node = node->next_, ++first)
+                node->value_ = *first;
+
+            if (first != last)
+                insert_chain(end_node(), create_chain(first, last));
+            else
+                erase_nodes(node, end_.prev_);
+        }
+    }
+
+    Iter insert_chain_at(Node *position, const Chain &chain) noexcept
+    {
+        insert_chain(position, chain);
+
+        return Iter(chain.size_ != 0 ? chain.first_ : position);
+    }
+
+    // Erases the matching nodes from position to the end in a single pass
+    // and updates size_ once, also when the predicate throws. The skip
+    // index is dropped up front instead of being checked on every removal.
+    template <typename NodePredicate>
+    size_t erase_nodes_if(Node *node, NodePredicate predicate)
+    {
+        size_t count = 0;
+
+        invalidate_index();
+
+        try
+        {
+            while (node != end_node())
+            {
+                Node *next = node->next_;
+                prefetch_for_read(next);
+
+                if (predicate(node))
+                {
+                    extract_nodes(node, node);
+                    deallocate_node(node);
+                    ++count;
+                }
+
+                node = next;
+            }
+        }
+        catch (...)
+        {
+            size_ -= count;
+            throw;
+        }
+
+        size_ -= count;
+
+        return count;
+    }
+
+    size_t destroy_nodes(Node *first, Node *end) noexcept
+    {
+        size_t count = 0;
+
+        while (first != end)
+        {
+            Node *tmp = first;
+            first = first->next_;
+            prefetch_for_write(first);
+            deallocate_node(tmp);
+            ++count;
+        }
+
+        return count;
+    }
+
     template <typename... Types>
     Node *create_node(Node *position, Types &&...args)
     {
-        Node *new_element = new Node(std::forward<Types>(args)...);
+        Node *new_element = allocate_node(std::forward<Types>(args)...);
 
-        insert_nodes(position, new_element, new_element);
+        emplace_nodes(position, new_element, new_element);
+        ++size_;
 
         return new_element;
     }
 
-    void insert_nodes(Node *position, Node *first, Node *last) noexcept
+    template <typename... Types>
+    Node *allocate_node(Types &&...args)
     {
-        size_ += count_nodes(first, last);
-        emplace_nodes(position, first, last);
+        Node *node = NodeAllocTraits::allocate(allocator_, 1);
+
+        try
+        {
+            NodeAllocTraits::construct(allocator_, node, std::forward<Types>(args)...);
+        }
+        catch (...)
+        {
+            NodeAllocTraits::deallocate(allocator_, node, 1);
+            throw;
+        }
+
+        return node;
+    }
+
+    void deallocate_node(Node *node) noexcept
+    {
+        NodeAllocTraits::destroy(allocator_, node);
+        NodeAllocTraits::deallocate(allocator_, node, 1);
     }
 
     void emplace_nodes(Node *position, Node *first, Node *last) noexcept
@@ -440,11 +1291,13 @@ private: // Internal logic
 
         last->next_ = position;
         position->prev_ = last;
+
+        note_inserted(first, last);
     }
 
-    inline size_t count_nodes(Node *first, Node *last) noexcept
+    inline size_t count_nodes(const Node *first, const Node *last) const noexcept
     {
-        int count = 1;
+        size_t count = 1;
 
         while (first != last)
         {
@@ -465,27 +1318,18 @@ private: // Internal logic
         if (first == nullptr || first == end_node())
             return first;
 
-        remove_nodes(first, last);
+        extract_nodes(first, last);
         Node *end = last->next_;
 
-        while (first != end)
-        {
-            Node *tmp = first;
-            first = first->next_;
-            delete tmp;
-        }
+        size_ -= destroy_nodes(first, end);
 
         return end;
     }
 
-    void remove_nodes(Node *first, Node *last) noexcept
-    {
-        size_ -= count_nodes(first, last);
-        extract_nodes(first, last);
-    }
-
     void extract_nodes(Node *first, Node *last) noexcept
     {
+        note_extracted(first, last);
+
         last->next_->prev_ = first->prev_;
 
         if (first->prev_ != nullptr)
@@ -495,13 +1339,23 @@ private: // Internal logic
     }
 
     template <typename... Types>
-    void resize_internal(size_t new_size, Types &&...args)
+    void resize_internal(size_t new_size, const Types &...args)
     {
-        while (new_size > size_)
-            emplace_back(std::forward<Types>(args)...);
+        if (new_size > size_)
+        {
+            insert_chain(end_node(), create_chain_n(new_size - size_, args...));
+            return;
+        }
 
-        while (new_size < size_)
-            pop_back();
+        if (new_size == size_)
+            return;
+
+        Node *first = end_.prev_;
+
+        for (size_t i = new_size + 1; i < size_; ++i)
+            first = first->prev_;
+
+        erase_nodes(first, end_.prev_);
     }
 
     Iter swap_nodes(Iter lhs, Iter rhs)
@@ -518,20 +1372,678 @@ private: // Internal logic
         return lhs;
     }
 
-    void splice_internal(Node *position, List &other, Node *first, Node *last)
+    using Run = typename ChainSort<Node>::Run;
+
+    // Sorts a null-terminated run in place. If compare throws, the run's head
+    // still leads to all of its nodes, in unspecified order.
+    template <typename CmpFunc>
+    static void sort_chain(Run &run, CmpFunc &compare)
     {
-        if (this == &other)
+        auto precedes = [&compare](const Node *lhs, const Node *rhs) { return compare(lhs->value_, rhs->value_); };
+
+        ChainSort<Node>::sort(run, precedes);
+    }
+
+    void attach_run(const Run &run) noexcept
+    {
+        invalidate_index();
+        first_ = run.head_;
+        first_->prev_ = nullptr;
+        run.tail_->next_ = end_node();
+        end_.prev_ = run.tail_;
+    }
+
+    // Detaches the whole chain as consecutive null-terminated runs of nearly
+    // equal length.
+    std::vector<Run> split_into_runs(size_t count)
+    {
+        std::vector<Run> runs;
+        runs.reserve(count);
+
+        Node *node = first_;
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            size_t length = size_ / count + (i < size_ % count ? 1 : 0);
+            Run run{node, node, length};
+
+            for (size_t step = 1; step < length; ++step)
+                run.tail_ = run.tail_->next_;
+
+            node = run.tail_->next_;
+            run.tail_->next_ = nullptr;
+            runs.push_back(run);
+        }
+
+        return runs;
+    }
+
+    // Appends second to the null-terminated chain that starts at first.
+    static Node *join_chains(Node *first, Node *second) noexcept
+    {
+        if (first == nullptr)
+            return second;
+
+        Node *tail = first;
+
+        while (tail->next_ != nullptr)
+            tail = tail->next_;
+
+        tail->next_ = second;
+
+        return first;
+    }
+
+    size_t segment_count(size_t threads) const noexcept
+    {
+        constexpr size_t min_segment_size = 1 << 12;
+        constexpr size_t segments_per_thread = 4;
+
+        if (threads < 2 || size_ == 0)
+            return 1;
+
+        return std::clamp<size_t>(size_ / min_segment_size, 1, threads * segments_per_thread);
+    }
+
+    template <typename Result, typename CombineOp>
+    static Result combine_partials(Result init, std::vector<std::optional<Result>> &partials, CombineOp &combine)
+    {
+        for (std::optional<Result> &partial : partials)
+        {
+            if (partial)
+                init = combine(std::move(init), std::move(*partial));
+        }
+
+        return init;
+    }
+
+    // Cuts the list into segment_count(threads) segments of nearly equal
+    // length and runs segment_func on each in the shared pool. The caller
+    // only follows next_ links to find where a segment ends and hands the
+    // segment over right away, then helps with the queued segments, so the
+    // workers don't wait for the whole list to be split. Several segments
+    // per thread even out uneven per-element costs.
+    template <typename SegmentFunc>
+    void run_segments(size_t threads, SegmentFunc segment_func) const
+    {
+        size_t segments = segment_count(threads);
+
+        if (segments == 1)
+        {
+            if (size_ != 0)
+                segment_func(0, first_, size_);
+
+            return;
+        }
+
+        ThreadPool &pool = ThreadPool::shared();
+        std::vector<std::future<void>> tasks;
+        std::exception_ptr error;
+
+        tasks.reserve(segments);
+
+        try
+        {
+            const Node *node = first_;
+
+            for (size_t i = 0; i < segments; ++i)
+            {
+                size_t length = size_ / segments + (i < size_ % segments ? 1 : 0);
+                const Node *first = node;
+
+                for (size_t step = 0; step < length; ++step)
+                    node = node->next_;
+
+                tasks.push_back(pool.submit([&segment_func, i, first, length] { segment_func(i, first, length); }));
+            }
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+
+        if (std::exception_ptr task_error = wait_for(pool, tasks); !error)
+            error = task_error;
+
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+    // Helps pool with queued tasks until all of tasks are done, so this
+    // also works when called from a task of the same pool.
+    static std::exception_ptr wait_for(ThreadPool &pool, std::vector<std::future<void>> &tasks)
+    {
+        std::exception_ptr error;
+
+        for (std::future<void> &task : tasks)
+            pool.wait(task);
+
+        for (std::future<void> &task : tasks)
+        {
+            try
+            {
+                task.get();
+            }
+            catch (...)
+            {
+                if (!error)
+                    error = std::current_exception();
+            }
+        }
+
+        tasks.clear();
+
+        return error;
+    }
+
+    // One side of a two-way merge of the same pair of runs. The front half
+    // takes the smallest elements in stable order, the back half takes the
+    // largest ones walking prev_ links, so the two never touch the same node.
+    struct HalfMerge
+    {
+        Node *left_ = nullptr;
+        Node *right_ = nullptr;
+        Node *head_ = nullptr;
+        Node *tail_ = nullptr;
+        size_t left_taken_ = 0;
+        size_t right_taken_ = 0;
+    };
+
+    template <typename CmpFunc>
+    static void merge_front(HalfMerge &half, const Run &lhs, const Run &rhs, size_t count, CmpFunc &compare)
+    {
+        while (half.left_taken_ + half.right_taken_ != count)
         {
-            other.extract_nodes(first, last);
-            emplace_nodes(position, first, last);
+            bool take_right = half.left_taken_ == lhs.length_ ||
+                              (half.right_taken_ != rhs.length_ && compare(half.right_->value_, half.left_->value_));
+
+            Node *node = take_right ? half.right_ : half.left_;
+
+            if (take_right)
+            {
+                half.right_ = node->next_;
+                ++half.right_taken_;
+            }
+            else
+            {
+                half.left_ = node->next_;
+                ++half.left_taken_;
+            }
+
+            if (half.tail_ != nullptr)
+                half.tail_->next_ = node;
+            else
+                half.head_ = node;
+
+            node->prev_ = half.tail_;
+            half.tail_ = node;
         }
+    }
+
+    template <typename CmpFunc>
+    static void merge_back(HalfMerge &half, const Run &lhs, const Run &rhs, size_t count, CmpFunc &compare)
+    {
+        while (half.left_taken_ + half.right_taken_ != count)
+        {
+            bool take_left = half.right_taken_ == rhs.length_ ||
+                             (half.left_taken_ != lhs.length_ && compare(half.right_->value_, half.left_->value_));
+
+            Node *node = take_left ? half.left_ : half.right_;
+
+            if (take_left)
+            {
+                half.left_ = node->prev_;
+                ++half.left_taken_;
+            }
+            else
+            {
+                half.right_ = node->prev_;
+                ++half.right_taken_;
+            }
+
+            if (half.head_ != nullptr)
+                half.head_->prev_ = node;
+            else
+                half.tail_ = node;
+
+            node->next_ = half.head_;
+            half.head_ = node;
+        }
+    }
+
+    static Run join_halves(const HalfMerge &front, const HalfMerge &back, size_t length) noexcept
+    {
+        front.tail_->next_ = back.head_;
+        back.head_->prev_ = front.tail_;
+
+        return Run{front.head_, back.tail_, length};
+    }
+
+    // Collects every node of an interrupted two-way merge into one
+    // null-terminated chain: both merged halves plus what neither reached.
+    static Node *recover_halves(const HalfMerge &front, const HalfMerge &back, const Run &lhs, const Run &rhs) noexcept
+    {
+        Node *head = nullptr;
+        Node *tail = nullptr;
+
+        auto append = [&head, &tail](Node *first, size_t count) noexcept
+        {
+            for (; count != 0; --count, first = first->next_)
+            {
+                if (tail != nullptr)
+                    tail->next_ = first;
+                else
+                    head = first;
+
+                tail = first;
+            }
+        };
+
+        append(front.head_, front.left_taken_ + front.right_taken_);
+        append(front.left_, lhs.length_ - front.left_taken_ - back.left_taken_);
+        append(front.right_, rhs.length_ - front.right_taken_ - back.right_taken_);
+        append(back.head_, back.left_taken_ + back.right_taken_);
+
+        if (tail != nullptr)
+            tail->next_ = nullptr;
+
+        return head;
+    }
+
+    // Links the nodes in the order of a sorted (key, node) array.
+    template <typename Key>
+    void relink_sorted(const std::vector<std::pair<Key, Node *>> &items) noexcept
+    {
+        Node *prev = nullptr;
+
+        invalidate_index();
+
+        for (const auto &item : items)
+        {
+            Node *node = item.second;
+
+            node->prev_ = prev;
+
+            if (prev != nullptr)
+                prev->next_ = node;
+
+            prev = node;
+        }
+
+        first_ = items.front().second;
+        prev->next_ = end_node();
+        end_.prev_ = prev;
+    }
+
+    // Puts the null-terminated runs of an interrupted parallel_sort back
+    // into the list in their current order.
+    void relink_runs(const std::vector<Run> &runs) noexcept
+    {
+        Node *head = nullptr;
+
+        for (auto it = runs.rbegin(); it != runs.rend(); ++it)
+            head = join_chains(it->head_, head);
+
+        relink_chain(head);
+    }
+
+    // Restores prev_ links, first_ and end_ after the list was rebuilt as a
+    // null-terminated chain of its own nodes.
+    void relink_chain(Node *head) noexcept
+    {
+        Node *prev = nullptr;
+
+        invalidate_index();
+        first_ = head;
+
+        for (Node *node = head; node != nullptr; node = node->next_)
+        {
+            node->prev_ = prev;
+            prev = node;
+        }
+
+        prev->next_ = end_node();
+        end_.prev_ = prev;
+    }
+
+    void swap_links(List &other) noexcept
+    {
+        if (empty())
+            first_ = other.end_node();
         else
+            end_node()->prev_->next_ = other.end_node();
+
+        if (other.empty())
+            other.first_ = end_node();
+        else
+            other.end_node()->prev_->next_ = end_node();
+
+        std::swap(size_, other.size_);
+        std::swap(first_, other.first_);
+        std::swap(end_, other.end_);
+        std::swap(index_, other.index_);
+        std::swap(finger_, other.finger_);
+    }
+
+    void splice_internal(Node *position, List &other, Node *first, Node *last, size_t count) noexcept
+    {
+        other.extract_nodes(first, last);
+        emplace_nodes(position, first, last);
+
+        if (this != &other)
         {
-            other.remove_nodes(first, last);
-            insert_nodes(position, first, last);
+            other.size_ -= count;
+            size_ += count;
         }
     }
 
+    // Every stride_-th node from the front, checkpoints_[i] sits at
+    // position shift_ + i * stride_. shift_ counts the nodes pushed in front
+    // of the first checkpoint since the index was built.
+    struct SkipIndex
+    {
+        std::vector<const Node *> checkpoints_;
+        std::unordered_map<const Node *, size_t> ordinals_;
+        size_t stride_ = 0;
+        size_t shift_ = 0;
+        bool valid_ = false;
+    };
+
+    static constexpr size_t min_skip_stride = 16;
+    static constexpr size_t skip_walk_limit = 64;
+
+    void invalidate_index() noexcept
+    {
+        if (index_ != nullptr)
+            index_->valid_ = false;
+    }
+
+    // Called right after [first, last] was linked in. Nodes appended at the
+    // end leave every position as it is and a single node pushed to the
+    // front only moves shift_. Any other change drops the index, so users
+    // who never ask for positions don't pay for keeping it; it is rebuilt
+    // on the next positional call. insert_sorted() keeps it up to date
+    // itself, see keep_index_after_insert().
+    void note_inserted(const Node *first, const Node *last) noexcept
+    {
+        if (index_ == nullptr || !index_->valid_ || last->next_ == end_node())
+            return;
+
+        SkipIndex &index = *index_;
+
+        if (first == last && first == first_ && !index.checkpoints_.empty())
+            ++index.shift_;
+        else
+            index.valid_ = false;
+    }
+
+    // Called right before [first, last] is unlinked. Mirrors note_inserted:
+    // only single nodes taken from either end keep the index.
+    void note_extracted(const Node *first, const Node *last) noexcept
+    {
+        if (finger_ != nullptr && (first != last || finger_ == first))
+            finger_ = nullptr;
+
+        if (index_ == nullptr || !index_->valid_)
+            return;
+
+        SkipIndex &index = *index_;
+
+        if (first != last || index.checkpoints_.empty())
+            index.valid_ = false;
+        else if (first->next_ == end_node())
+        {
+            if (index.checkpoints_.back() == first)
+                move_checkpoint(index, index.checkpoints_.size() - 1, nullptr);
+        }
+        else if (first == first_ && index.shift_ != 0)
+            --index.shift_;
+        else
+            index.valid_ = false;
+    }
+
+    // Repairs the index note_inserted() dropped for node, which was just
+    // linked in somewhere in the middle. insert_sorted() relies on the
+    // index for long walks, so it pays for keeping it instead of
+    // rebuilding it after every insertion.
+    void keep_index_after_insert(const Node *node, bool was_valid) noexcept
+    {
+        if (!was_valid || index_->valid_ || index_->checkpoints_.empty())
+            return;
+
+        index_->valid_ = true;
+        shift_checkpoints(*index_, node->prev_);
+    }
+
+    // Finds the nearest checkpoint at or before node, the predecessor of
+    // an inserted node, and moves the ones behind it one node back.
+    // Without such a checkpoint the insertion lies in front of the first
+    // one and only shift_ moves.
+    void shift_checkpoints(SkipIndex &index, const Node *node) noexcept
+    {
+        for (const Node *at = node; at != nullptr; at = at->prev_)
+        {
+            auto found = index.ordinals_.find(at);
+
+            if (found == index.ordinals_.end())
+                continue;
+
+            for (size_t i = found->second + 1; i < index.checkpoints_.size(); ++i)
+                move_checkpoint(index, i, index.checkpoints_[i]->prev_);
+
+            return;
+        }
+
+        ++index.shift_;
+    }
+
+    // Moves checkpoint ordinal to node, or drops it (it has to be the last
+    // one) when node is null or the end. Reuses the map entry, so it doesn't
+    // allocate.
+    void move_checkpoint(SkipIndex &index, size_t ordinal, const Node *node) noexcept
+    {
+        auto entry = index.ordinals_.extract(index.checkpoints_[ordinal]);
+
+        if (node == nullptr || node == end_node())
+        {
+            index.checkpoints_.pop_back();
+            return;
+        }
+
+        entry.key() = node;
+        index.ordinals_.insert(std::move(entry));
+        index.checkpoints_[ordinal] = node;
+    }
+
+    // Rebuilds the index when it was dropped or no longer fits the size,
+    // and adds checkpoints for nodes appended since it was built.
+    const SkipIndex &skip_index() const
+    {
+        if (index_ == nullptr)
+            index_ = std::make_unique<SkipIndex>();
+
+        SkipIndex &index = *index_;
+        size_t stride = std::max(min_skip_stride, static_cast<size_t>(std::sqrt(static_cast<double>(size_))));
+
+        if (!index.valid_ || index.checkpoints_.empty() || index.shift_ >= 2 * index.stride_ ||
+            stride >= 2 * index.stride_ || 2 * stride <= index.stride_)
+        {
+            index.checkpoints_.clear();
+            index.ordinals_.clear();
+            index.stride_ = stride;
+            index.shift_ = 0;
+            index.valid_ = true;
+
+            if (size_ == 0)
+                return index;
+
+            index.checkpoints_.push_back(first_);
+            index.ordinals_.emplace(first_, 0);
+        }
+
+        size_t last = index.shift_ + (index.checkpoints_.size() - 1) * index.stride_;
+
+        if (size_ - last > index.stride_)
+        {
+            const Node *node = index.checkpoints_.back();
+
+            for (; size_ - last > index.stride_; last += index.stride_)
+            {
+                for (size_t step = 0; step < index.stride_; ++step)
+                    node = node->next_;
+
+                index.ordinals_.emplace(node, index.checkpoints_.size());
+                index.checkpoints_.push_back(node);
+            }
+        }
+
+        return index;
+    }
+
+    // Starts from whichever of the front, the back or the two surrounding
+    // checkpoints is closest.
+    const Node *nth_node(size_t position) const
+    {
+        if (position >= size_)
+            return end_node();
+
+        if (position < skip_walk_limit)
+            return walk(first_, position);
+
+        if (size_ - position <= skip_walk_limit)
+            return walk(end_node(), -static_cast<std::ptrdiff_t>(size_ - position));
+
+        const SkipIndex &index = skip_index();
+
+        if (position < index.shift_)
+            return walk(first_, position);
+
+        size_t ordinal = std::min((position - index.shift_) / index.stride_, index.checkpoints_.size() - 1);
+        size_t checkpoint = index.shift_ + ordinal * index.stride_;
+        size_t forward = position - checkpoint;
+
+        if (forward <= index.stride_ / 2 || ordinal + 1 == index.checkpoints_.size())
+        {
+            if (size_ - position < forward)
+                return walk(end_node(), -static_cast<std::ptrdiff_t>(size_ - position));
+
+            return walk(index.checkpoints_[ordinal], forward);
+        }
+
+        return walk(index.checkpoints_[ordinal + 1], -static_cast<std::ptrdiff_t>(checkpoint + index.stride_ - position));
+    }
+
+    // Walks back to the front or to the nearest checkpoint.
+    size_t node_index(const Node *node) const
+    {
+        if (node == end_node())
+            return size_;
+
+        const SkipIndex &index = skip_index();
+        size_t steps = 0;
+
+        for (; node != first_; node = node->prev_, ++steps)
+        {
+            auto found = index.ordinals_.find(node);
+
+            if (found != index.ordinals_.end())
+                return index.shift_ + found->second * index.stride_ + steps;
+        }
+
+        return steps;
+    }
+
+    // Nodes for which this holds come before the lower (upper) bound of
+    // value, the rest after it.
+    template <typename Key, typename CmpFunc>
+    static bool precedes_bound(const Node *node, const Key &value, CmpFunc &compare, bool upper)
+    {
+        return upper ? !compare(value, node->value_) : compare(node->value_, value);
+    }
+
+    template <typename Key, typename CmpFunc>
+    const Node *bound_node(const Key &value, CmpFunc &compare, bool upper) const
+    {
+        const Node *node = first_;
+
+        if (size_ > 2 * skip_walk_limit)
+        {
+            const std::vector<const Node *> &checkpoints = skip_index().checkpoints_;
+
+            auto after = std::partition_point(checkpoints.begin(), checkpoints.end(),
+                                              [&value, &compare, upper](const Node *checkpoint)
+                                              { return precedes_bound(checkpoint, value, compare, upper); });
+
+            if (after != checkpoints.begin())
+                node = (*std::prev(after))->next_;
+        }
+
+        while (node != end_node() && precedes_bound(node, value, compare, upper))
+            node = node->next_;
+
+        return node;
+    }
+
+    template <typename CmpFunc>
+    Iter insert_sorted_from(Node *start, Type &&value, CmpFunc &compare)
+    {
+        Node *position = nullptr;
+        size_t steps = 0;
+
+        if (start != end_node() && precedes_bound(start, value, compare, true))
+        {
+            position = start->next_;
+
+            while (position != end_node() && precedes_bound(position, value, compare, true))
+            {
+                position = position->next_;
+
+                if (++steps == skip_walk_limit && index_ != nullptr && index_->valid_)
+                {
+                    position = const_cast<Node *>(bound_node(value, compare, true));
+                    break;
+                }
+            }
+        }
+        else
+        {
+            Node *prev = start == end_node() ? end_.prev_ : start->prev_;
+
+            while (prev != nullptr && !precedes_bound(prev, value, compare, true))
+            {
+                prev = prev->prev_;
+
+                if (++steps == skip_walk_limit && index_ != nullptr && index_->valid_)
+                {
+                    prev = nullptr;
+                    position = const_cast<Node *>(bound_node(value, compare, true));
+                    break;
+                }
+            }
+
+            if (position == nullptr)
+                position = prev != nullptr ? prev->next_ : first_;
+        }
+
+        bool index_was_valid = index_ != nullptr && index_->valid_;
+
+        finger_ = create_node(position, std::move(value));
+        keep_index_after_insert(finger_, index_was_valid);
+
+        return Iter(finger_);
+    }
+
+    static const Node *walk(const Node *node, std::ptrdiff_t distance) noexcept
+    {
+        for (; distance > 0; --distance)
+            node = node->next_;
+
+        for (; distance < 0; ++distance)
+            node = node->prev_;
+
+        return node;
+    }
+
     inline Node *end_node() noexcept
     {
         return reinterpret_cast<Node *>(&end_);
@@ -549,7 +2061,10 @@ private:
     };
 
 private:
+    NodeAllocator allocator_;
     size_t size_ = 0;
     Node *first_ = end_node();
     EndNode end_;
+    mutable std::unique_ptr<SkipIndex> index_;
+    Node *finger_ = nullptr;
 };
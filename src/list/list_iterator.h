@@ -1,8 +1,9 @@
 #pragma once
 
 #include <iterator>
+#include <type_traits>
 
-template <typename Type>
+template <typename Type, typename Allocator>
 class List;
 
 template <class NodeType, typename Type>
@@ -25,11 +26,19 @@ public:
     {
     }
 
-    ListIterator(const DeConstedIter &other) : node_(other.node_)
+    ListIterator(const ListIterator &other) = default;
+
+    // Only converts to the const iterator; copies of either kind go through
+    // the defaulted copy constructor.
+    template <typename OtherIter,
+              typename = std::enable_if_t<std::is_const_v<Type> && std::is_same_v<OtherIter, DeConstedIter>>>
+    ListIterator(const OtherIter &other) : node_(other.node_)
     {
     }
 
-    reference operator*()
+    ListIterator &operator=(const ListIterator &other) = default;
+
+    reference operator*() const
     {
         return node_->value_;
     }
@@ -77,8 +86,8 @@ private:
     }
 
 private:
-    friend class List<Type>;
-    friend class List<DeConstedType>;
+    template <typename, typename>
+    friend class List;
     friend class ListIterator<const NodeType, const Type>;
 
 private:
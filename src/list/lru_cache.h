@@ -0,0 +1,307 @@
+#pragma once
+
+#include "list.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+// Least recently used cache on top of List. Entries are kept in a List from
+// the most to the least recently used one, and every entry also carries the
+// link of its hash chain, so an entry costs a single node allocation and a
+// lookup never leaves the nodes. Using an entry splices its node to the
+// front, eviction splices nodes off the back.
+//
+// The capacity bounds either the number of entries or, when a weigher is
+// given, the sum of the weights it assigns to entries (e.g. their size in
+// bytes). put() evicts down to the capacity but always keeps the entry it
+// stored, even when that one alone exceeds the capacity.
+template <typename Key, typename Value, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+class LruCache
+{
+private:
+    struct Entry;
+
+    using EntryList = List<Entry>;
+    using EntryIter = typename EntryList::iterator;
+
+    struct Entry
+    {
+        Key key_;
+        Value value_;
+        size_t hash_;
+        size_t weight_;
+        EntryIter chain_next_;
+    };
+
+    static constexpr size_t min_bucket_count = 16;
+
+public: // Member types
+    using key_type = Key;
+    using mapped_type = Value;
+    using Weigher = std::function<size_t(const Key &, const Value &)>;
+
+public: // Special member functions
+    explicit LruCache(size_t max_entries, const Hash &hash = Hash(), const KeyEqual &equal = KeyEqual())
+        : capacity_(max_entries), hash_(hash), equal_(equal), buckets_(min_bucket_count, null_entry())
+    {
+    }
+
+    LruCache(size_t max_weight, Weigher weigher, const Hash &hash = Hash(), const KeyEqual &equal = KeyEqual())
+        : capacity_(max_weight), weigher_(std::move(weigher)), hash_(hash), equal_(equal),
+          buckets_(min_bucket_count, null_entry())
+    {
+    }
+
+    // Chains link nodes of entries_ directly, a copy would have to rebuild
+    // all of them.
+    LruCache(const LruCache &) = delete;
+    LruCache &operator=(const LruCache &) = delete;
+
+    // A moved-from cache may only be destroyed or assigned to.
+    LruCache(LruCache &&) = default;
+    LruCache &operator=(LruCache &&) = default;
+
+public: // Size-related methods
+    size_t size() const noexcept
+    {
+        return entries_.size();
+    }
+
+    bool empty() const noexcept
+    {
+        return entries_.empty();
+    }
+
+    size_t capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+    // Number of entries, or the sum of their weights with a weigher.
+    size_t weight() const noexcept
+    {
+        return weight_;
+    }
+
+public: // Lookup methods
+    // Marks the entry as the most recently used one. The pointer stays
+    // valid until the entry is evicted or erased.
+    Value *get(const Key &key)
+    {
+        EntryIter it = find_entry(key, hash_(key));
+
+        if (it == null_entry())
+            return nullptr;
+
+        move_to_front(it);
+
+        return &(*it).value_;
+    }
+
+    // Looks the entry up without changing the eviction order.
+    const Value *peek(const Key &key) const
+    {
+        EntryIter it = find_entry(key, hash_(key));
+
+        return it == null_entry() ? nullptr : &(*it).value_;
+    }
+
+    bool contains(const Key &key) const
+    {
+        return find_entry(key, hash_(key)) != null_entry();
+    }
+
+    bool touch(const Key &key)
+    {
+        return get(key) != nullptr;
+    }
+
+public: // Modifying methods
+    template <typename ValueType>
+    Value &put(const Key &key, ValueType &&value)
+    {
+        return put(key, std::forward<ValueType>(value), [](Key &&, Value &&) {});
+    }
+
+    // Inserts or overwrites the entry and makes it the most recently used
+    // one, then evicts down to the capacity passing evicted entries to
+    // on_evict(Key &&, Value &&).
+    template <typename ValueType, typename Func>
+    Value &put(const Key &key, ValueType &&value, Func on_evict)
+    {
+        size_t hash = hash_(key);
+        EntryIter it = find_entry(key, hash);
+
+        // The value is weighed before the cache is touched, so a throwing
+        // weigher leaves it as it was.
+        Value stored(std::forward<ValueType>(value));
+        size_t weight = weigh(key, stored);
+
+        if (it != null_entry())
+        {
+            Entry &entry = *it;
+
+            entry.value_ = std::move(stored);
+            weight_ = weight_ - entry.weight_ + weight;
+            entry.weight_ = weight;
+
+            move_to_front(it);
+        }
+        else
+        {
+            if (entries_.size() >= buckets_.size())
+                rehash(buckets_.size() * 2);
+
+            EntryIter &head = buckets_[hash & (buckets_.size() - 1)];
+
+            entries_.emplace_front(Entry{key, std::move(stored), hash, weight, head});
+            it = entries_.begin();
+            head = it;
+            weight_ += weight;
+        }
+
+        size_t count = 0;
+        size_t excess = weight_ > capacity_ ? weight_ - capacity_ : 0;
+
+        // Counts how many entries from the back have to go, at least one
+        // stays.
+        for (auto last = std::prev(entries_.end()); excess != 0 && count + 1 < entries_.size(); --last)
+        {
+            excess -= std::min(excess, (*last).weight_);
+            ++count;
+        }
+
+        evict(count, on_evict);
+
+        return (*it).value_;
+    }
+
+    bool erase(const Key &key)
+    {
+        size_t hash = hash_(key);
+        EntryIter it = find_entry(key, hash);
+
+        if (it == null_entry())
+            return false;
+
+        unlink_from_chain(it);
+        weight_ -= (*it).weight_;
+        entries_.erase(it);
+
+        return true;
+    }
+
+    size_t evict(size_t count)
+    {
+        return evict(count, [](Key &&, Value &&) {});
+    }
+
+    // Evicts up to count least recently used entries and hands them to
+    // on_evict(Key &&, Value &&), least recently used first. The entries are
+    // detached with one splice before the first call, so on_evict may use
+    // the cache.
+    template <typename Func>
+    size_t evict(size_t count, Func on_evict)
+    {
+        count = std::min(count, entries_.size());
+
+        if (count == 0)
+            return 0;
+
+        EntryIter first = entries_.end();
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            --first;
+            unlink_from_chain(first);
+            weight_ -= (*first).weight_;
+        }
+
+        EntryList evicted;
+        evicted.splice(evicted.cend(), entries_, first, entries_.cend(), count);
+
+        for (auto it = evicted.rbegin(); it != evicted.rend(); ++it)
+            on_evict(std::move((*it).key_), std::move((*it).value_));
+
+        return count;
+    }
+
+    void clear() noexcept
+    {
+        entries_.clear();
+        std::fill(buckets_.begin(), buckets_.end(), null_entry());
+        weight_ = 0;
+    }
+
+private: // Internal logic
+    static EntryIter null_entry() noexcept
+    {
+        return EntryIter(nullptr);
+    }
+
+    size_t weigh(const Key &key, const Value &value) const
+    {
+        return weigher_ ? weigher_(key, value) : 1;
+    }
+
+    EntryIter find_entry(const Key &key, size_t hash) const
+    {
+        EntryIter it = buckets_[hash & (buckets_.size() - 1)];
+
+        while (it != null_entry())
+        {
+            Entry &entry = *it;
+
+            if (entry.hash_ == hash && equal_(entry.key_, key))
+                break;
+
+            it = entry.chain_next_;
+        }
+
+        return it;
+    }
+
+    void move_to_front(EntryIter it) noexcept
+    {
+        entries_.splice(entries_.cbegin(), entries_, it);
+    }
+
+    void unlink_from_chain(EntryIter it) noexcept
+    {
+        EntryIter *link = &buckets_[(*it).hash_ & (buckets_.size() - 1)];
+
+        while (*link != it)
+            link = &(**link).chain_next_;
+
+        *link = (*it).chain_next_;
+    }
+
+    void rehash(size_t bucket_count)
+    {
+        std::vector<EntryIter> buckets(bucket_count, null_entry());
+
+        for (EntryIter it = entries_.begin(); it != entries_.end(); ++it)
+        {
+            Entry &entry = *it;
+            EntryIter &head = buckets[entry.hash_ & (bucket_count - 1)];
+
+            entry.chain_next_ = head;
+            head = it;
+        }
+
+        buckets_.swap(buckets);
+    }
+
+private:
+    size_t capacity_;
+    size_t weight_ = 0;
+    Weigher weigher_;
+    Hash hash_;
+    KeyEqual equal_;
+    EntryList entries_;
+    std::vector<EntryIter> buckets_;
+};
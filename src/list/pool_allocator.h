@@ -0,0 +1,192 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace pool_allocator
+{
+    // Free list of equally sized slots carved out of chunks of slot_count
+    // slots each.
+    class Pool
+    {
+    public:
+        Pool(size_t slot_size, size_t alignment, size_t slot_count)
+            : slot_size_(slot_size), alignment_(alignment), slot_count_(slot_count), chunk_used_(slot_count)
+        {
+        }
+
+        Pool(const Pool &) = delete;
+        Pool &operator=(const Pool &) = delete;
+
+        ~Pool()
+        {
+            for (void *chunk : chunks_)
+                ::operator delete(chunk, std::align_val_t(alignment_));
+        }
+
+        void *allocate()
+        {
+            if (free_list_ != nullptr)
+            {
+                void *slot = free_list_;
+                free_list_ = *static_cast<void **>(slot);
+                return slot;
+            }
+
+            if (chunk_used_ == slot_count_)
+            {
+                // Grows ahead of the chunk allocation, so push_back can't
+                // throw and leak the chunk.
+                if (chunks_.size() == chunks_.capacity())
+                    chunks_.reserve(2 * chunks_.size() + 1);
+
+                chunks_.push_back(::operator new(slot_size_ * slot_count_, std::align_val_t(alignment_)));
+                chunk_used_ = 0;
+            }
+
+            return static_cast<unsigned char *>(chunks_.back()) + slot_size_ * chunk_used_++;
+        }
+
+        void deallocate(void *slot) noexcept
+        {
+            *static_cast<void **>(slot) = free_list_;
+            free_list_ = slot;
+        }
+
+        bool serves(size_t slot_size, size_t alignment) const noexcept
+        {
+            return slot_size_ == slot_size && alignment_ == alignment;
+        }
+
+    private:
+        size_t slot_size_;
+        size_t alignment_;
+        size_t slot_count_;
+        size_t chunk_used_;
+        void *free_list_ = nullptr;
+        std::vector<void *> chunks_;
+    };
+
+    // The pools shared by an allocator and all allocators rebound from it,
+    // one per slot size.
+    class Arena
+    {
+    public:
+        Pool &pool_for(size_t slot_size, size_t alignment, size_t slot_count)
+        {
+            for (const std::unique_ptr<Pool> &pool : pools_)
+            {
+                if (pool->serves(slot_size, alignment))
+                    return *pool;
+            }
+
+            pools_.push_back(std::make_unique<Pool>(slot_size, alignment, slot_count));
+            return *pools_.back();
+        }
+
+    private:
+        std::vector<std::unique_ptr<Pool>> pools_;
+    };
+}
+
+// Allocator that carves single objects out of large chunks and recycles freed
+// ones through an intrusive free list. Copies and rebound copies share the
+// same arena and compare equal, containers copying their allocator get a
+// fresh one. The arena is not thread-safe.
+template <typename Type, size_t NodesPerChunk = 256>
+class PoolAllocator
+{
+    static_assert(NodesPerChunk > 0, "A chunk has to hold at least one node");
+
+    template <typename, size_t>
+    friend class PoolAllocator;
+
+public:
+    using value_type = Type;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    using is_always_equal = std::false_type;
+
+    template <typename Other>
+    struct rebind
+    {
+        using other = PoolAllocator<Other, NodesPerChunk>;
+    };
+
+private:
+    static constexpr size_t slot_alignment = alignof(Type) > alignof(void *) ? alignof(Type) : alignof(void *);
+    static constexpr size_t slot_size =
+        ((sizeof(Type) > sizeof(void *) ? sizeof(Type) : sizeof(void *)) + slot_alignment - 1) / slot_alignment *
+        slot_alignment;
+
+public: // Special member functions
+    PoolAllocator() : arena_(std::make_shared<pool_allocator::Arena>())
+    {
+    }
+
+    PoolAllocator(const PoolAllocator &other) noexcept = default;
+
+    // The pool for Type is looked up on the first allocation, so rebinding
+    // doesn't allocate.
+    template <typename Other>
+    PoolAllocator(const PoolAllocator<Other, NodesPerChunk> &other) noexcept : arena_(other.arena_)
+    {
+    }
+
+    PoolAllocator &operator=(const PoolAllocator &other) noexcept = default;
+
+public: // Allocation
+    Type *allocate(size_t n)
+    {
+        if (n != 1)
+            return std::allocator<Type>().allocate(n);
+
+        return static_cast<Type *>(pool().allocate());
+    }
+
+    void deallocate(Type *pointer, size_t n) noexcept
+    {
+        if (n != 1)
+        {
+            std::allocator<Type>().deallocate(pointer, n);
+            return;
+        }
+
+        // The pool exists already since pointer came from it.
+        pool().deallocate(pointer);
+    }
+
+    PoolAllocator select_on_container_copy_construction() const
+    {
+        return PoolAllocator();
+    }
+
+    template <typename Other>
+    bool operator==(const PoolAllocator<Other, NodesPerChunk> &other) const noexcept
+    {
+        return arena_ == other.arena_;
+    }
+
+    template <typename Other>
+    bool operator!=(const PoolAllocator<Other, NodesPerChunk> &other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+private: // Internal logic
+    pool_allocator::Pool &pool()
+    {
+        if (pool_ == nullptr)
+            pool_ = &arena_->pool_for(slot_size, slot_alignment, NodesPerChunk);
+
+        return *pool_;
+    }
+
+private:
+    std::shared_ptr<pool_allocator::Arena> arena_;
+    pool_allocator::Pool *pool_ = nullptr;
+};
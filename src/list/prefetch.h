@@ -0,0 +1,220 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+// Asks the cache to fetch a node a traversal is about to visit. Prefetching
+// never faults, so address may be null or point past the end of a list.
+inline void prefetch_for_read(const void *address) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address, 0, 3);
+#else
+    (void)address;
+#endif
+}
+
+inline void prefetch_for_write(const void *address) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address, 1, 3);
+#else
+    (void)address;
+#endif
+}
+
+// Splits [first, last) of size elements into lanes segments of equal length
+// with a single walk and returns their lanes + 1 boundaries. A linked list
+// only has one chain of dependent loads, walking several segments in
+// lockstep keeps that many loads in flight at once. The boundaries stay
+// valid as long as the boundary elements aren't erased, so a split can be
+// reused by repeated traversals.
+template <typename Iterator>
+std::vector<Iterator> split_into_lanes(Iterator first, Iterator last, size_t size, size_t lanes)
+{
+    lanes = std::max<size_t>(1, std::min(lanes, size));
+
+    std::vector<Iterator> bounds;
+    bounds.reserve(lanes + 1);
+    bounds.push_back(first);
+
+    for (size_t lane = 1; lane < lanes; ++lane)
+    {
+        size_t length = size / lanes + (lane - 1 < size % lanes ? 1 : 0);
+
+        std::advance(first, length);
+        bounds.push_back(first);
+    }
+
+    bounds.push_back(last);
+
+    return bounds;
+}
+
+template <class Container>
+auto split_into_lanes(Container &container, size_t lanes)
+{
+    return split_into_lanes(container.begin(), container.end(), container.size(), lanes);
+}
+
+// Calls function for every element of the split, advancing all lanes in
+// lockstep. Elements of one lane are visited in order, but lanes interleave.
+template <typename Iterator, typename Function>
+void for_each_interleaved(const std::vector<Iterator> &bounds, Function function)
+{
+    if (bounds.size() == 2)
+    {
+        std::for_each(bounds.front(), bounds.back(), function);
+        return;
+    }
+
+    std::vector<Iterator> cursors(bounds.begin(), bounds.end() - 1);
+    size_t active = cursors.size();
+
+    while (active != 0)
+    {
+        active = 0;
+
+        for (size_t lane = 0; lane < cursors.size(); ++lane)
+        {
+            if (cursors[lane] == bounds[lane + 1])
+                continue;
+
+            function(*cursors[lane]);
+            ++cursors[lane];
+            ++active;
+        }
+    }
+}
+
+namespace prefetch
+{
+    // Advances all lanes in lockstep folding every element into the
+    // partial result of its lane, then combines the partial results in lane
+    // order.
+    template <typename Iterator, typename Value, typename Fold, typename Combine>
+    Value fold_lanes(const std::vector<Iterator> &bounds, std::vector<Iterator> &cursors, std::vector<Value> &partials,
+                     Fold &fold, Combine &combine)
+    {
+        size_t active = cursors.size();
+
+        while (active != 0)
+        {
+            active = 0;
+
+            for (size_t lane = 0; lane < cursors.size(); ++lane)
+            {
+                if (cursors[lane] == bounds[lane + 1])
+                    continue;
+
+                partials[lane] = fold(std::move(partials[lane]), *cursors[lane]);
+                ++cursors[lane];
+                ++active;
+            }
+        }
+
+        Value result = std::move(partials.front());
+
+        for (size_t lane = 1; lane < partials.size(); ++lane)
+            result = combine(std::move(result), std::move(partials[lane]));
+
+        return result;
+    }
+}
+
+// Folds every lane on its own and combines the partial results in lane
+// order, so operation has to be associative but not commutative. Like
+// std::reduce, operation combines elements as well as partial results: the
+// first lane starts from init, the others from their first element, which
+// has to convert to Value. For folds that don't fit this, use the overload
+// with a separate combine.
+template <typename Iterator, typename Value, typename Operation>
+Value accumulate_interleaved(const std::vector<Iterator> &bounds, Value init, Operation operation)
+{
+    const size_t lanes = bounds.size() - 1;
+
+    if (lanes == 1)
+        return std::accumulate(bounds.front(), bounds.back(), std::move(init), operation);
+
+    std::vector<Iterator> cursors(bounds.begin(), bounds.end() - 1);
+    std::vector<Value> partials;
+
+    partials.reserve(lanes);
+    partials.push_back(std::move(init));
+
+    // split_into_lanes never leaves a lane empty.
+    for (size_t lane = 1; lane < lanes; ++lane)
+        partials.emplace_back(*cursors[lane]++);
+
+    return prefetch::fold_lanes(bounds, cursors, partials, operation, operation);
+}
+
+// Folds every lane with fold(Value, element) starting from a copy of init
+// and combines the partial results with combine(Value, Value) in lane
+// order. init seeds every lane, so it has to be an identity of combine,
+// e.g. 0 for a count.
+template <typename Iterator, typename Value, typename Fold, typename Combine>
+Value accumulate_interleaved(const std::vector<Iterator> &bounds, Value init, Fold fold, Combine combine)
+{
+    const size_t lanes = bounds.size() - 1;
+
+    if (lanes == 1)
+        return std::accumulate(bounds.front(), bounds.back(), std::move(init), fold);
+
+    std::vector<Iterator> cursors(bounds.begin(), bounds.end() - 1);
+    std::vector<Value> partials(lanes, init);
+
+    return prefetch::fold_lanes(bounds, cursors, partials, fold, combine);
+}
+
+template <typename Iterator, typename Value>
+Value accumulate_interleaved(const std::vector<Iterator> &bounds, Value init)
+{
+    return accumulate_interleaved(bounds, std::move(init), std::plus<>());
+}
+
+// Returns the first element in list order that satisfies predicate, or the
+// last boundary. Once a lane finds a match the lanes after it stop.
+template <typename Iterator, typename Predicate>
+Iterator find_if_interleaved(const std::vector<Iterator> &bounds, Predicate predicate)
+{
+    if (bounds.size() == 2)
+        return std::find_if(bounds.front(), bounds.back(), predicate);
+
+    std::vector<Iterator> cursors(bounds.begin(), bounds.end() - 1);
+    size_t limit = cursors.size();
+    size_t active = limit;
+
+    while (active != 0)
+    {
+        active = 0;
+
+        for (size_t lane = 0; lane < limit; ++lane)
+        {
+            if (cursors[lane] == bounds[lane + 1])
+                continue;
+
+            if (predicate(*cursors[lane]))
+            {
+                limit = lane;
+                break;
+            }
+
+            ++cursors[lane];
+            ++active;
+        }
+    }
+
+    for (size_t lane = 0; lane < cursors.size(); ++lane)
+    {
+        if (cursors[lane] != bounds[lane + 1])
+            return cursors[lane];
+    }
+
+    return bounds.back();
+}
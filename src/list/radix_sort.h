@@ -0,0 +1,116 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+template <size_t Size>
+struct UnsignedOfSize;
+
+template <>
+struct UnsignedOfSize<1>
+{
+    using type = uint8_t;
+};
+
+template <>
+struct UnsignedOfSize<2>
+{
+    using type = uint16_t;
+};
+
+template <>
+struct UnsignedOfSize<4>
+{
+    using type = uint32_t;
+};
+
+template <>
+struct UnsignedOfSize<8>
+{
+    using type = uint64_t;
+};
+
+template <typename Key>
+inline constexpr bool is_radix_sortable_v =
+    (std::is_integral_v<Key> && !std::is_same_v<Key, bool>) ||
+    std::is_same_v<Key, float> || std::is_same_v<Key, double>;
+
+template <typename CmpFunc, typename Key>
+inline constexpr bool is_ascending_order_v =
+    std::is_same_v<CmpFunc, std::less<Key>> || std::is_same_v<CmpFunc, std::less<>>;
+
+template <typename CmpFunc, typename Key>
+inline constexpr bool is_descending_order_v =
+    std::is_same_v<CmpFunc, std::greater<Key>> || std::is_same_v<CmpFunc, std::greater<>>;
+
+template <typename Key>
+using RadixKey = typename UnsignedOfSize<sizeof(Key)>::type;
+
+// Maps a key to an unsigned integer with the same ascending order: the sign
+// bit of signed integers is flipped, negative floating point values get all
+// their bits flipped. -0.0 is mapped to 0.0, so both zeros keep their input
+// order like with std::less, and NaNs end up at either end.
+template <typename Key>
+RadixKey<Key> to_radix_key(Key key, bool descending = false) noexcept
+{
+    using Unsigned = RadixKey<Key>;
+    constexpr Unsigned sign_bit = Unsigned(1) << (sizeof(Key) * 8 - 1);
+
+    if constexpr (std::is_floating_point_v<Key>)
+    {
+        if (key == Key(0))
+            key = Key(0);
+    }
+
+    Unsigned bits;
+    std::memcpy(&bits, &key, sizeof(Key));
+
+    if constexpr (std::is_floating_point_v<Key>)
+        bits = (bits & sign_bit) ? Unsigned(~bits) : Unsigned(bits | sign_bit);
+    else if constexpr (std::is_signed_v<Key>)
+        bits ^= sign_bit;
+
+    return descending ? Unsigned(~bits) : bits;
+}
+
+// Stable LSD radix sort by the first member, one byte per pass. Passes in
+// which every key shares the same byte are skipped.
+template <typename Unsigned, typename Payload>
+void radix_sort(std::vector<std::pair<Unsigned, Payload>> &items)
+{
+    constexpr size_t passes = sizeof(Unsigned);
+
+    if (items.size() < 2)
+        return;
+
+    std::array<std::array<size_t, 256>, passes> counts{};
+
+    for (const auto &item : items)
+        for (size_t pass = 0; pass < passes; ++pass)
+            ++counts[pass][(item.first >> (pass * 8)) & 0xFF];
+
+    std::vector<std::pair<Unsigned, Payload>> buffer(items.size());
+
+    for (size_t pass = 0; pass < passes; ++pass)
+    {
+        std::array<size_t, 256> &offsets = counts[pass];
+
+        if (offsets[(items.front().first >> (pass * 8)) & 0xFF] == items.size())
+            continue;
+
+        size_t total = 0;
+
+        for (size_t &offset : offsets)
+            total += std::exchange(offset, total);
+
+        for (const auto &item : items)
+            buffer[offsets[(item.first >> (pass * 8)) & 0xFF]++] = item;
+
+        items.swap(buffer);
+    }
+}
@@ -0,0 +1,386 @@
+#pragma once
+
+#include "list.h"
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+// Storage for N list nodes embedded in the owning object. Free slots are
+// chained through an intrusive free list.
+template <typename Type, size_t N>
+class InlineNodeArena
+{
+    static_assert(N > 0, "The arena has to hold at least one node");
+
+public:
+    // Mirrors List's nodes: two links followed by the value.
+    struct NodeLayout
+    {
+        void *prev_;
+        void *next_;
+        Type value_;
+    };
+
+private:
+    union Slot
+    {
+        Slot *next_;
+        alignas(NodeLayout) unsigned char storage_[sizeof(NodeLayout)];
+    };
+
+public: // Special member functions
+    InlineNodeArena() noexcept
+    {
+        for (size_t i = 0; i + 1 < N; ++i)
+            slots_[i].next_ = &slots_[i + 1];
+
+        slots_[N - 1].next_ = nullptr;
+    }
+
+    InlineNodeArena(const InlineNodeArena &) = delete;
+    InlineNodeArena &operator=(const InlineNodeArena &) = delete;
+
+public: // Allocation
+    // Returns nullptr once every slot is taken.
+    void *allocate() noexcept
+    {
+        Slot *slot = free_list_;
+
+        if (slot == nullptr)
+            return nullptr;
+
+        free_list_ = slot->next_;
+        ++used_;
+
+        return slot->storage_;
+    }
+
+    void deallocate(void *pointer) noexcept
+    {
+        Slot *slot = reinterpret_cast<Slot *>(pointer);
+
+        slot->next_ = free_list_;
+        free_list_ = slot;
+        --used_;
+    }
+
+    bool owns(const void *pointer) const noexcept
+    {
+        std::less<const void *> less;
+
+        return !less(pointer, slots_) && less(pointer, slots_ + N);
+    }
+
+    size_t used() const noexcept
+    {
+        return used_;
+    }
+
+private:
+    Slot slots_[N];
+    Slot *free_list_ = slots_;
+    size_t used_ = 0;
+};
+
+// Allocator that serves single nodes from an InlineNodeArena while it has
+// free slots and falls back to the heap afterwards. It never propagates, a
+// container keeps the arena it was created with.
+template <typename Type, class Arena>
+class InlineNodeAllocator
+{
+    static constexpr bool fits_slot = sizeof(Type) <= sizeof(typename Arena::NodeLayout) &&
+                                      alignof(Type) <= alignof(typename Arena::NodeLayout);
+
+public:
+    using value_type = Type;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::false_type;
+    using propagate_on_container_swap = std::false_type;
+    using is_always_equal = std::false_type;
+
+    template <typename Other>
+    struct rebind
+    {
+        using other = InlineNodeAllocator<Other, Arena>;
+    };
+
+public: // Special member functions
+    InlineNodeAllocator() noexcept = default;
+
+    explicit InlineNodeAllocator(Arena *arena) noexcept : arena_(arena)
+    {
+    }
+
+    template <typename Other>
+    InlineNodeAllocator(const InlineNodeAllocator<Other, Arena> &other) noexcept : arena_(other.arena_)
+    {
+    }
+
+public: // Allocation
+    Type *allocate(size_t n)
+    {
+        if constexpr (fits_slot)
+        {
+            if (n == 1 && arena_ != nullptr)
+            {
+                if (void *slot = arena_->allocate())
+                    return static_cast<Type *>(slot);
+            }
+        }
+
+        return std::allocator<Type>().allocate(n);
+    }
+
+    void deallocate(Type *pointer, size_t n) noexcept
+    {
+        if (arena_ != nullptr && arena_->owns(pointer))
+            arena_->deallocate(pointer);
+        else
+            std::allocator<Type>().deallocate(pointer, n);
+    }
+
+    InlineNodeAllocator select_on_container_copy_construction() const noexcept
+    {
+        return InlineNodeAllocator();
+    }
+
+    bool operator==(const InlineNodeAllocator &other) const noexcept
+    {
+        return arena_ == other.arena_;
+    }
+
+    bool operator!=(const InlineNodeAllocator &other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+private:
+    template <typename, class>
+    friend class InlineNodeAllocator;
+
+    Arena *arena_ = nullptr;
+};
+
+// List that keeps its first N nodes inside the object and only goes to the
+// heap for the ones beyond that. Heap nodes are spliced by relinking as in
+// List, while inline nodes can't leave their arena: moving, swapping or
+// splicing them moves the element into a node of the destination instead,
+// which invalidates iterators to it. Splicing from a list that currently
+// uses no inline slots stays O(1).
+template <typename Type, size_t N = 4>
+class SmallList : private InlineNodeArena<Type, N>,
+                  private List<Type, InlineNodeAllocator<Type, InlineNodeArena<Type, N>>>
+{
+private:
+    using Arena = InlineNodeArena<Type, N>;
+    using Allocator = InlineNodeAllocator<Type, Arena>;
+    using Base = List<Type, Allocator>;
+
+public: // Member types
+    using value_type = Type;
+    using iterator = typename Base::iterator;
+    using const_iterator = typename Base::const_iterator;
+
+    static constexpr size_t inline_capacity = N;
+
+public: // Special member functions
+    SmallList() noexcept : Base(Allocator(arena()))
+    {
+    }
+
+    SmallList(std::initializer_list<Type> values) : SmallList()
+    {
+        Base::assign(values);
+    }
+
+    template <typename _InputIterator,
+              typename = std::_RequireInputIter<_InputIterator>>
+    SmallList(_InputIterator first, _InputIterator last) : SmallList()
+    {
+        Base::assign(first, last);
+    }
+
+    SmallList(const SmallList &other) : SmallList()
+    {
+        Base::assign(other.begin(), other.end());
+    }
+
+    SmallList(SmallList &&other) noexcept(std::is_nothrow_move_constructible_v<Type>) : SmallList()
+    {
+        splice(cend(), other);
+    }
+
+    SmallList &operator=(const SmallList &other)
+    {
+        if (this != &other)
+            assign(other.begin(), other.end());
+
+        return *this;
+    }
+
+    SmallList &operator=(SmallList &&other) noexcept(std::is_nothrow_move_constructible_v<Type>)
+    {
+        if (this != &other)
+        {
+            clear();
+            splice(cend(), other);
+        }
+
+        return *this;
+    }
+
+public: // Size-related methods
+    using Base::empty;
+    using Base::size;
+
+    // Number of elements currently stored inside the object.
+    size_t inline_size() const noexcept
+    {
+        return arena()->used();
+    }
+
+public: // Member access methods
+    using Base::back;
+    using Base::front;
+
+public: // Modifying methods
+    using Base::clear;
+    using Base::emplace_back;
+    using Base::emplace_front;
+    using Base::pop_back;
+    using Base::pop_front;
+    using Base::push_back;
+    using Base::push_front;
+    using Base::resize;
+
+    // Unlike List::assign the old elements go first, so the new ones can
+    // take their inline slots.
+    void assign(std::initializer_list<Type> values)
+    {
+        clear();
+        Base::assign(values);
+    }
+
+    template <typename _InputIterator,
+              typename = std::_RequireInputIter<_InputIterator>>
+    void assign(_InputIterator first, _InputIterator last)
+    {
+        clear();
+        Base::assign(first, last);
+    }
+
+    void swap(SmallList &other)
+    {
+        if (this == &other)
+            return;
+
+        if (inline_size() == 0 && other.inline_size() == 0)
+        {
+            Base::swap(other);
+            return;
+        }
+
+        SmallList temp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(temp);
+    }
+
+public: // Algorithms
+    using Base::remove;
+    using Base::remove_if;
+    using Base::reverse;
+    using Base::sort;
+    using Base::sort_by_key;
+    using Base::unique;
+
+    void splice(const_iterator position, SmallList &other)
+    {
+        if (this == &other || other.empty())
+            return;
+
+        if (other.inline_size() == 0)
+            Base::splice(position, other);
+        else
+            splice(position, other, other.cbegin(), other.cend());
+    }
+
+    void splice(const_iterator position, SmallList &other, const_iterator begin, const_iterator end)
+    {
+        if (this == &other || other.inline_size() == 0)
+        {
+            Base::splice(position, other, begin, end);
+            return;
+        }
+
+        while (begin != end)
+            splice(position, other, begin++);
+    }
+
+    void splice(const_iterator position, SmallList &other, const_iterator it)
+    {
+        if (this == &other || !other.arena()->owns(&*it))
+        {
+            Base::splice(position, other, it);
+            return;
+        }
+
+        Base::emplace(position, std::move(const_cast<Type &>(*it)));
+        other.Base::erase(it);
+    }
+
+    void merge(SmallList &other)
+    {
+        merge(other, std::less<Type>());
+    }
+
+    template <typename CmpFunc>
+    void merge(SmallList &other, CmpFunc compare)
+    {
+        if (this == &other)
+            return;
+
+        const_iterator position = cbegin();
+
+        while (!other.empty())
+        {
+            while (position != cend() && !compare(other.front(), *position))
+                ++position;
+
+            if (position == cend())
+                break;
+
+            splice(position, other, other.cbegin());
+        }
+
+        splice(cend(), other);
+    }
+
+public: // Iterator-related methods
+    using Base::emplace;
+    using Base::erase;
+    using Base::insert;
+
+public: // Fabric methods
+    using Base::begin;
+    using Base::cbegin;
+    using Base::cend;
+    using Base::crbegin;
+    using Base::crend;
+    using Base::end;
+    using Base::rbegin;
+    using Base::rend;
+
+private: // Internal logic
+    Arena *arena() noexcept
+    {
+        return this;
+    }
+
+    const Arena *arena() const noexcept
+    {
+        return this;
+    }
+};
@@ -0,0 +1,590 @@
+#pragma once
+
+#include "unrolled_list_iterator.h"
+
+#include <algorithm>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+template <class BlockType, typename Type>
+class UnrolledListIterator;
+
+// Doubly linked list of blocks that hold up to N elements each. It keeps the
+// List interface, but elements live inline in their block, so any insertion
+// or removal may move neighbouring elements and invalidate their iterators.
+template <typename Type, size_t N = (sizeof(Type) < 32 ? 256 / sizeof(Type) : 8)>
+class UnrolledList
+{
+    static_assert(N > 1, "A block has to hold at least two elements");
+
+private:
+    // Erasing shifts the following elements of the block and may merge it
+    // with the next one, so it only can't throw when moving can't.
+    static constexpr bool nothrow_moves =
+        std::is_nothrow_move_constructible_v<Type> && std::is_nothrow_move_assignable_v<Type>;
+
+    struct BlockLink
+    {
+        BlockLink *prev_ = nullptr;
+        BlockLink *next_ = nullptr;
+    };
+
+    struct Block : BlockLink
+    {
+        using Link = BlockLink;
+
+        Type *data() noexcept
+        {
+            return std::launder(reinterpret_cast<Type *>(storage_));
+        }
+
+        const Type *data() const noexcept
+        {
+            return std::launder(reinterpret_cast<const Type *>(storage_));
+        }
+
+        template <typename... Types>
+        void emplace_at(size_t index, Types &&...args)
+        {
+            if (index == count_)
+            {
+                ::new (data() + count_) Type(std::forward<Types>(args)...);
+                ++count_;
+                return;
+            }
+
+            Type value(std::forward<Types>(args)...);
+
+            ::new (data() + count_) Type(std::move(data()[count_ - 1]));
+            ++count_;
+
+            std::move_backward(data() + index, data() + count_ - 2, data() + count_ - 1);
+            data()[index] = std::move(value);
+        }
+
+        void erase_at(size_t index) noexcept(nothrow_moves)
+        {
+            std::move(data() + index + 1, data() + count_, data() + index);
+            std::destroy_at(data() + --count_);
+        }
+
+        void move_tail_to(size_t index, Block *destination)
+        {
+            std::uninitialized_move(data() + index, data() + count_, destination->data() + destination->count_);
+            std::destroy(data() + index, data() + count_);
+
+            destination->count_ += count_ - index;
+            count_ = index;
+        }
+
+        size_t count_ = 0;
+        alignas(Type) unsigned char storage_[N * sizeof(Type)];
+    };
+
+    using Iter = UnrolledListIterator<Block, Type>;
+    using ConstIter = UnrolledListIterator<const Block, const Type>;
+    using ReverseIter = std::reverse_iterator<Iter>;
+    using ConstReverseIter = std::reverse_iterator<ConstIter>;
+
+public: // Special member functions
+    UnrolledList() = default;
+
+    UnrolledList(std::initializer_list<Type> values)
+    {
+        for (const Type &val : values)
+            emplace_back(val);
+    }
+
+    template <typename _InputIterator,
+              typename = std::_RequireInputIter<_InputIterator>>
+    UnrolledList(_InputIterator first, _InputIterator last)
+    {
+        for (; first != last; ++first)
+            emplace_back(*first);
+    }
+
+    UnrolledList(const UnrolledList &other) : UnrolledList(other.begin(), other.end())
+    {
+    }
+
+    UnrolledList(UnrolledList &&other) noexcept
+    {
+        swap(other);
+    }
+
+    UnrolledList &operator=(const UnrolledList &other)
+    {
+        if (this != &other)
+            UnrolledList(other).swap(*this);
+
+        return *this;
+    }
+
+    UnrolledList &operator=(UnrolledList &&other) noexcept
+    {
+        if (this != &other)
+            UnrolledList(std::move(other)).swap(*this);
+
+        return *this;
+    }
+
+    ~UnrolledList()
+    {
+        clear();
+    }
+
+public: // Size-related methods
+    size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+public: // Member access methods
+    Type &front() noexcept
+    {
+        return block(header_.next_)->data()[0];
+    }
+
+    const Type &front() const noexcept
+    {
+        return block(header_.next_)->data()[0];
+    }
+
+    Type &back() noexcept
+    {
+        Block *last = block(header_.prev_);
+        return last->data()[last->count_ - 1];
+    }
+
+    const Type &back() const noexcept
+    {
+        const Block *last = block(header_.prev_);
+        return last->data()[last->count_ - 1];
+    }
+
+public: // Modifying methods
+    void push_front(const Type &value)
+    {
+        emplace(cbegin(), value);
+    }
+
+    void push_front(Type &&value)
+    {
+        emplace(cbegin(), std::move(value));
+    }
+
+    template <typename... Types>
+    void emplace_front(Types &&...args)
+    {
+        emplace(cbegin(), std::forward<Types>(args)...);
+    }
+
+    void push_back(const Type &value)
+    {
+        emplace(cend(), value);
+    }
+
+    void push_back(Type &&value)
+    {
+        emplace(cend(), std::move(value));
+    }
+
+    template <typename... Types>
+    void emplace_back(Types &&...args)
+    {
+        emplace(cend(), std::forward<Types>(args)...);
+    }
+
+    void pop_front() noexcept(nothrow_moves)
+    {
+        erase(begin());
+    }
+
+    void pop_back() noexcept
+    {
+        Block *last = block(header_.prev_);
+
+        std::destroy_at(last->data() + --last->count_);
+        --size_;
+
+        if (last->count_ == 0)
+            free_block(last);
+    }
+
+    void swap(UnrolledList &other) noexcept
+    {
+        std::swap(header_, other.header_);
+        std::swap(size_, other.size_);
+
+        relink_header(other);
+        other.relink_header(*this);
+    }
+
+    void clear() noexcept
+    {
+        while (header_.next_ != &header_)
+        {
+            Block *first = block(header_.next_);
+
+            std::destroy(first->data(), first->data() + first->count_);
+            first->count_ = 0;
+            free_block(first);
+        }
+
+        size_ = 0;
+    }
+
+public: // Algorithms
+    void sort()
+    {
+        sort(std::less<Type>());
+    }
+
+    // Elements are moved out into one contiguous buffer, sorted there and
+    // moved back, so the block layout stays untouched.
+    template <typename CmpFunc>
+    void sort(CmpFunc compare)
+    {
+        if (size_ < 2)
+            return;
+
+        std::vector<Type> buffer;
+        buffer.reserve(size_);
+
+        for (Type &value : *this)
+            buffer.push_back(std::move(value));
+
+        std::stable_sort(buffer.begin(), buffer.end(), compare);
+        std::move(buffer.begin(), buffer.end(), begin());
+    }
+
+    void splice(ConstIter position, UnrolledList &other)
+    {
+        if (this == &other || other.empty())
+            return;
+
+        BlockLink *next = split_at(position.get_link(), position.index_);
+
+        link_blocks(next, other.header_.next_, other.header_.prev_);
+        size_ += other.size_;
+
+        other.header_.next_ = other.header_.prev_ = &other.header_;
+        other.size_ = 0;
+    }
+
+    void splice(ConstIter position, UnrolledList &other, ConstIter begin, ConstIter end)
+    {
+        if (begin == end)
+            return;
+
+        BlockLink *pos_link = position.get_link();
+        size_t pos_index = position.index_;
+
+        BlockLink *last_link = other.split_at(end.get_link(), end.index_);
+
+        if (pos_link == end.get_link() && pos_index >= end.index_ && end.index_ != 0)
+        {
+            pos_link = last_link;
+            pos_index -= end.index_;
+        }
+
+        BlockLink *first_link = other.split_at(begin.get_link(), begin.index_);
+        BlockLink *next = split_at(pos_link, pos_index);
+        BlockLink *tail = last_link->prev_;
+
+        if (this != &other)
+        {
+            size_t count = 0;
+
+            for (BlockLink *link = first_link; link != last_link; link = link->next_)
+                count += block(link)->count_;
+
+            other.size_ -= count;
+            size_ += count;
+        }
+
+        unlink_blocks(first_link, tail);
+        link_blocks(next, first_link, tail);
+    }
+
+    void splice(ConstIter position, UnrolledList &other, ConstIter it)
+    {
+        if (this == &other)
+        {
+            splice(position, other, it, std::next(it));
+            return;
+        }
+
+        Iter source(it.get_link(), it.index_);
+
+        emplace(position, std::move(*source));
+        other.erase(source);
+    }
+
+    void reverse() noexcept
+    {
+        BlockLink *link = &header_;
+
+        do
+        {
+            std::swap(link->prev_, link->next_);
+            link = link->prev_;
+
+            if (link != &header_)
+                std::reverse(block(link)->data(), block(link)->data() + block(link)->count_);
+        } while (link != &header_);
+    }
+
+    void merge(UnrolledList &other)
+    {
+        merge(other, std::less<Type>());
+    }
+
+    template <typename CmpFunc>
+    void merge(UnrolledList &other, CmpFunc compare)
+    {
+        if (this == &other || other.empty())
+            return;
+
+        UnrolledList result;
+        Iter lhs = begin();
+        Iter rhs = other.begin();
+
+        while (lhs != end() && rhs != other.end())
+        {
+            if (compare(*rhs, *lhs))
+                result.emplace_back(std::move(*rhs++));
+            else
+                result.emplace_back(std::move(*lhs++));
+        }
+
+        for (; lhs != end(); ++lhs)
+            result.emplace_back(std::move(*lhs));
+
+        for (; rhs != other.end(); ++rhs)
+            result.emplace_back(std::move(*rhs));
+
+        other.clear();
+        swap(result);
+    }
+
+public: // Iterator-related methods
+    Iter erase(ConstIter it) noexcept(nothrow_moves)
+    {
+        Block *current = block(it.get_link());
+        size_t index = it.index_;
+
+        current->erase_at(index);
+        --size_;
+
+        if (current->count_ == 0)
+        {
+            BlockLink *next = current->next_;
+            free_block(current);
+            return Iter(next, 0);
+        }
+
+        BlockLink *next = current->next_;
+
+        if (next != &header_ && current->count_ + block(next)->count_ <= N / 2)
+        {
+            block(next)->move_tail_to(0, current);
+            free_block(block(next));
+        }
+
+        if (index == current->count_)
+            return Iter(current->next_, 0);
+
+        return Iter(current, index);
+    }
+
+    Iter insert(ConstIter it, const Type &value)
+    {
+        return emplace(it, value);
+    }
+
+    Iter insert(ConstIter it, Type &&value)
+    {
+        return emplace(it, std::move(value));
+    }
+
+    template <typename... Types>
+    Iter emplace(ConstIter it, Types &&...args)
+    {
+        BlockLink *link = it.get_link();
+        size_t index = it.index_;
+
+        if (index == 0 && link->prev_ != &header_ && block(link->prev_)->count_ < N)
+        {
+            link = link->prev_;
+            index = block(link)->count_;
+        }
+        else if (link == &header_ || (index == 0 && link->prev_ == &header_ && block(link)->count_ == N))
+        {
+            link = allocate_block(link);
+        }
+        else if (block(link)->count_ == N)
+        {
+            // The split moves half of the block, so the value is built before
+            // in case args refer to one of the moved elements.
+            Type value(std::forward<Types>(args)...);
+            BlockLink *tail = split_at(link, N / 2);
+
+            if (index > N / 2)
+            {
+                link = tail;
+                index -= N / 2;
+            }
+
+            block(link)->emplace_at(index, std::move(value));
+            ++size_;
+
+            return Iter(link, index);
+        }
+
+        try
+        {
+            block(link)->emplace_at(index, std::forward<Types>(args)...);
+        }
+        catch (...)
+        {
+            if (block(link)->count_ == 0)
+                free_block(block(link));
+
+            throw;
+        }
+
+        ++size_;
+
+        return Iter(link, index);
+    }
+
+public: // Fabric methods
+    Iter begin() noexcept
+    {
+        return Iter(header_.next_, 0);
+    }
+
+    Iter end() noexcept
+    {
+        return Iter(&header_, 0);
+    }
+
+    ConstIter begin() const noexcept
+    {
+        return ConstIter(header_.next_, 0);
+    }
+
+    ConstIter end() const noexcept
+    {
+        return ConstIter(&header_, 0);
+    }
+
+    ConstIter cbegin() const noexcept
+    {
+        return ConstIter(header_.next_, 0);
+    }
+
+    ConstIter cend() const noexcept
+    {
+        return ConstIter(&header_, 0);
+    }
+
+    ReverseIter rbegin() noexcept
+    {
+        return ReverseIter(end());
+    }
+
+    ReverseIter rend() noexcept
+    {
+        return ReverseIter(begin());
+    }
+
+    ConstReverseIter crbegin() const noexcept
+    {
+        return ConstReverseIter(cend());
+    }
+
+    ConstReverseIter crend() const noexcept
+    {
+        return ConstReverseIter(cbegin());
+    }
+
+private: // Internal logic
+    static Block *block(BlockLink *link) noexcept
+    {
+        return static_cast<Block *>(link);
+    }
+
+    static const Block *block(const BlockLink *link) noexcept
+    {
+        return static_cast<const Block *>(link);
+    }
+
+    Block *allocate_block(BlockLink *position)
+    {
+        Block *new_block = new Block;
+
+        link_blocks(position, new_block, new_block);
+
+        return new_block;
+    }
+
+    void free_block(Block *old_block) noexcept
+    {
+        unlink_blocks(old_block, old_block);
+        delete old_block;
+    }
+
+    static void link_blocks(BlockLink *position, BlockLink *first, BlockLink *last) noexcept
+    {
+        first->prev_ = position->prev_;
+        last->next_ = position;
+
+        position->prev_->next_ = first;
+        position->prev_ = last;
+    }
+
+    static void unlink_blocks(BlockLink *first, BlockLink *last) noexcept
+    {
+        first->prev_->next_ = last->next_;
+        last->next_->prev_ = first->prev_;
+    }
+
+    // Makes the element at index the first one of its block and returns that
+    // block, so whole blocks can be relinked around the position.
+    BlockLink *split_at(BlockLink *link, size_t index)
+    {
+        if (index == 0)
+            return link;
+
+        Block *tail = allocate_block(link->next_);
+        block(link)->move_tail_to(index, tail);
+
+        return tail;
+    }
+
+    void relink_header(UnrolledList &other) noexcept
+    {
+        if (header_.next_ == &other.header_)
+        {
+            header_.next_ = header_.prev_ = &header_;
+            return;
+        }
+
+        header_.next_->prev_ = &header_;
+        header_.prev_->next_ = &header_;
+    }
+
+private:
+    size_t size_ = 0;
+    BlockLink header_{&header_, &header_};
+};
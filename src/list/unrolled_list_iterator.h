@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+template <typename Type, size_t N>
+class UnrolledList;
+
+template <class BlockType, typename Type>
+class UnrolledListIterator
+{
+public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Type;
+    using pointer = Type *;
+    using reference = Type &;
+    using difference_type = std::ptrdiff_t;
+
+private:
+    using DeConstedBlock = std::remove_const_t<BlockType>;
+    using DeConstedType = std::remove_const_t<Type>;
+    using DeConstedIter = UnrolledListIterator<DeConstedBlock, DeConstedType>;
+    using DeConstedLink = typename DeConstedBlock::Link;
+    using Link = std::conditional_t<std::is_const_v<BlockType>, const DeConstedLink, DeConstedLink>;
+
+public:
+    UnrolledListIterator(Link *link, size_t index) : link_(link), index_(index)
+    {
+    }
+
+    UnrolledListIterator(const UnrolledListIterator &other) = default;
+
+    template <typename OtherIter,
+              typename = std::enable_if_t<std::is_const_v<Type> && std::is_same_v<OtherIter, DeConstedIter>>>
+    UnrolledListIterator(const OtherIter &other) : link_(other.link_), index_(other.index_)
+    {
+    }
+
+    UnrolledListIterator &operator=(const UnrolledListIterator &other) = default;
+
+    reference operator*()
+    {
+        return block()->data()[index_];
+    }
+
+    pointer operator->()
+    {
+        return block()->data() + index_;
+    }
+
+    UnrolledListIterator &operator++()
+    {
+        if (++index_ == block()->count_)
+        {
+            link_ = link_->next_;
+            index_ = 0;
+        }
+
+        return *this;
+    }
+
+    UnrolledListIterator operator++(int)
+    {
+        UnrolledListIterator temp = *this;
+        ++*this;
+        return temp;
+    }
+
+    UnrolledListIterator &operator--()
+    {
+        if (index_ == 0)
+        {
+            link_ = link_->prev_;
+            index_ = block()->count_;
+        }
+
+        --index_;
+        return *this;
+    }
+
+    UnrolledListIterator operator--(int)
+    {
+        UnrolledListIterator temp = *this;
+        --*this;
+        return temp;
+    }
+
+    bool operator==(const UnrolledListIterator &other) const
+    {
+        return link_ == other.link_ && index_ == other.index_;
+    }
+
+    bool operator!=(const UnrolledListIterator &other) const
+    {
+        return !(*this == other);
+    }
+
+private:
+    BlockType *block() const noexcept
+    {
+        return static_cast<BlockType *>(link_);
+    }
+
+    DeConstedLink *get_link() const noexcept
+    {
+        return const_cast<DeConstedLink *>(link_);
+    }
+
+private:
+    template <typename, size_t>
+    friend class UnrolledList;
+    friend class UnrolledListIterator<const BlockType, const Type>;
+
+private:
+    Link *link_;
+    size_t index_;
+};
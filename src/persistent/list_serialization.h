@@ -0,0 +1,402 @@
+#pragma once
+
+#include <list/list.h>
+#include <persistent/stream.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <sys/uio.h>
+
+// Binary format for List, written and read in bounded chunks so neither
+// side needs the whole list in one buffer:
+//
+//   header   "LISTDATA", uint32 version, uint32 value size (0 if encoded)
+//   chunk    uint32 count, uint32 bytes, then bytes of payload
+//   ...
+//   end      a chunk with count 0
+//
+// Trivially copyable values are stored as raw bytes in native byte order,
+// other types go through a ValueCodec specialization. Malformed or
+// truncated input throws std::runtime_error.
+
+// Encodes a value by appending bytes to out, decodes it by consuming bytes
+// from [data, end). Specialize it for types that aren't trivially copyable;
+// an encoded value has to take at least one byte.
+template <typename Type, typename = void>
+struct ValueCodec;
+
+template <typename Char, typename Traits, typename Allocator>
+struct ValueCodec<std::basic_string<Char, Traits, Allocator>>
+{
+    static_assert(std::is_trivially_copyable_v<Char>);
+
+    using String = std::basic_string<Char, Traits, Allocator>;
+
+    static void encode(const String &value, std::vector<unsigned char> &out)
+    {
+        uint64_t length = value.size();
+        size_t offset = out.size();
+
+        out.resize(offset + sizeof(length) + length * sizeof(Char));
+        std::memcpy(out.data() + offset, &length, sizeof(length));
+
+        if (length != 0)
+            std::memcpy(out.data() + offset + sizeof(length), value.data(), length * sizeof(Char));
+    }
+
+    static String decode(const unsigned char *&data, const unsigned char *end)
+    {
+        uint64_t length;
+
+        if (static_cast<size_t>(end - data) < sizeof(length))
+            throw std::runtime_error("Truncated string length");
+
+        std::memcpy(&length, data, sizeof(length));
+        data += sizeof(length);
+
+        if (length > static_cast<size_t>(end - data) / sizeof(Char))
+            throw std::runtime_error("Truncated string");
+
+        String value(static_cast<size_t>(length), Char());
+
+        if (length != 0)
+            std::memcpy(value.data(), data, length * sizeof(Char));
+
+        data += length * sizeof(Char);
+
+        return value;
+    }
+};
+
+namespace list_serialization
+{
+    inline constexpr char magic[8] = {'L', 'I', 'S', 'T', 'D', 'A', 'T', 'A'};
+    inline constexpr uint32_t format_version = 1;
+    inline constexpr size_t default_chunk_bytes = 64 * 1024;
+
+    struct Header
+    {
+        char magic_[8];
+        uint32_t version_;
+        uint32_t value_size_;
+    };
+
+    struct ChunkHeader
+    {
+        uint32_t count_;
+        uint32_t bytes_;
+    };
+
+    template <typename Sink, typename = void>
+    struct has_writev : std::false_type
+    {
+    };
+
+    template <typename Sink>
+    struct has_writev<Sink, std::void_t<decltype(std::declval<Sink &>().writev(std::declval<iovec *>(), 0))>>
+        : std::true_type
+    {
+    };
+
+    // Raw storage for trivially copyable values, so chunks can be filled
+    // and read without default constructing Type.
+    template <typename Type>
+    struct alignas(Type) Slot
+    {
+        unsigned char bytes_[sizeof(Type)];
+    };
+
+    template <typename Type>
+    constexpr uint32_t stored_value_size() noexcept
+    {
+        return std::is_trivially_copyable_v<Type> ? static_cast<uint32_t>(sizeof(Type)) : 0;
+    }
+
+    template <typename Sink>
+    void write_chunk(Sink &sink, ChunkHeader header, const void *payload)
+    {
+        if constexpr (has_writev<Sink>::value)
+        {
+            iovec parts[2] = {{&header, sizeof(header)}, {const_cast<void *>(payload), header.bytes_}};
+
+            sink.writev(parts, header.bytes_ != 0 ? 2 : 1);
+        }
+        else
+        {
+            sink.write(&header, sizeof(header));
+
+            if (header.bytes_ != 0)
+                sink.write(payload, header.bytes_);
+        }
+    }
+
+    template <typename Source>
+    void read_exact(Source &source, void *data, size_t size)
+    {
+        if (source.read(data, size) != size)
+            throw std::runtime_error("Truncated list stream");
+    }
+}
+
+// Writes values chunk by chunk as they come. finish() has to be called
+// after the last value, otherwise the stream lacks its end marker and
+// reading it fails.
+template <typename Type, typename Sink>
+class ListWriter
+{
+    static constexpr bool is_raw = std::is_trivially_copyable_v<Type>;
+
+    using Slot = list_serialization::Slot<Type>;
+
+public: // Special member functions
+    explicit ListWriter(Sink &sink, size_t chunk_bytes = list_serialization::default_chunk_bytes)
+        : sink_(sink), chunk_bytes_(std::clamp<size_t>(chunk_bytes, 1, UINT32_MAX))
+    {
+        list_serialization::Header header{};
+
+        std::memcpy(header.magic_, list_serialization::magic, sizeof(header.magic_));
+        header.version_ = list_serialization::format_version;
+        header.value_size_ = list_serialization::stored_value_size<Type>();
+
+        sink_.write(&header, sizeof(header));
+
+        if constexpr (is_raw)
+            slots_.resize(std::max<size_t>(1, chunk_bytes_ / sizeof(Type)));
+    }
+
+    ListWriter(const ListWriter &) = delete;
+    ListWriter &operator=(const ListWriter &) = delete;
+
+public: // Modifying methods
+    void write(const Type &value)
+    {
+        if constexpr (is_raw)
+        {
+            std::memcpy(slots_[count_].bytes_, std::addressof(value), sizeof(Type));
+
+            if (++count_ == slots_.size())
+                flush_chunk();
+        }
+        else
+        {
+            size_t offset = bytes_.size();
+
+            ValueCodec<Type>::encode(value, bytes_);
+
+            if (bytes_.size() > UINT32_MAX)
+            {
+                bytes_.resize(offset);
+                throw std::length_error("Encoded value doesn't fit into a chunk");
+            }
+
+            ++count_;
+
+            if (bytes_.size() >= chunk_bytes_)
+                flush_chunk();
+        }
+    }
+
+    template <typename _InputIterator>
+    void write(_InputIterator first, _InputIterator last)
+    {
+        for (; first != last; ++first)
+            write(*first);
+    }
+
+    void finish()
+    {
+        flush_chunk();
+        list_serialization::write_chunk(sink_, {0, 0}, nullptr);
+    }
+
+private: // Internal logic
+    void flush_chunk()
+    {
+        if (count_ == 0)
+            return;
+
+        if constexpr (is_raw)
+        {
+            list_serialization::write_chunk(
+                sink_, {static_cast<uint32_t>(count_), static_cast<uint32_t>(count_ * sizeof(Type))}, slots_.data());
+        }
+        else
+        {
+            list_serialization::write_chunk(
+                sink_, {static_cast<uint32_t>(count_), static_cast<uint32_t>(bytes_.size())}, bytes_.data());
+            bytes_.clear();
+        }
+
+        count_ = 0;
+    }
+
+private:
+    Sink &sink_;
+    size_t chunk_bytes_;
+    size_t count_ = 0;
+    std::vector<Slot> slots_;
+    std::vector<unsigned char> bytes_;
+};
+
+// Reads a stream written by ListWriter one chunk at a time, so a caller can
+// process and drop each chunk before reading the next.
+template <typename Type, typename Source, typename Allocator = std::allocator<Type>>
+class ListReader
+{
+    static constexpr bool is_raw = std::is_trivially_copyable_v<Type>;
+
+    using Slot = list_serialization::Slot<Type>;
+
+public: // Special member functions
+    explicit ListReader(Source &source) : source_(source)
+    {
+        list_serialization::Header header;
+
+        list_serialization::read_exact(source_, &header, sizeof(header));
+
+        if (std::memcmp(header.magic_, list_serialization::magic, sizeof(header.magic_)) != 0)
+            throw std::runtime_error("Not a list stream");
+
+        if (header.version_ != list_serialization::format_version)
+            throw std::runtime_error("Unsupported list stream version");
+
+        if (header.value_size_ != list_serialization::stored_value_size<Type>())
+            throw std::runtime_error("List stream was written for a different value type");
+    }
+
+    ListReader(const ListReader &) = delete;
+    ListReader &operator=(const ListReader &) = delete;
+
+public: // Modifying methods
+    // Appends the next chunk to out, allocating the nodes with out's own
+    // allocator. Returns false once the end marker was read, after which out
+    // is left unchanged.
+    bool read_chunk(List<Type, Allocator> &out)
+    {
+        if (finished_)
+            return false;
+
+        list_serialization::ChunkHeader header;
+
+        list_serialization::read_exact(source_, &header, sizeof(header));
+
+        if (header.count_ == 0)
+        {
+            if (header.bytes_ != 0)
+                throw std::runtime_error("Malformed end of list stream");
+
+            finished_ = true;
+            return false;
+        }
+
+        // The header isn't trusted, so memory only grows with the bytes that
+        // actually arrive.
+        if constexpr (is_raw)
+        {
+            if (header.bytes_ != uint64_t(header.count_) * sizeof(Type))
+                throw std::runtime_error("Malformed list stream chunk");
+
+            size_t piece_count = std::max<size_t>(1, list_serialization::default_chunk_bytes / sizeof(Type));
+
+            slots_.resize(std::min<size_t>(header.count_, piece_count));
+
+            size_t old_size = out.size();
+            auto first_read = out.end();
+
+            try
+            {
+                for (size_t remaining = header.count_; remaining != 0;)
+                {
+                    size_t count = std::min(remaining, slots_.size());
+
+                    list_serialization::read_exact(source_, slots_.data(), count * sizeof(Type));
+
+                    const Type *values = std::launder(reinterpret_cast<const Type *>(slots_.data()));
+                    auto inserted = out.insert(out.cend(), values, values + count);
+
+                    if (remaining == header.count_)
+                        first_read = inserted;
+
+                    remaining -= count;
+                }
+            }
+            catch (...)
+            {
+                if (out.size() != old_size)
+                    out.erase(first_read, out.cend());
+
+                throw;
+            }
+        }
+        else
+        {
+            // Every encoded value takes at least one byte.
+            if (header.count_ > header.bytes_)
+                throw std::runtime_error("Malformed list stream chunk");
+
+            bytes_.clear();
+
+            while (bytes_.size() < header.bytes_)
+            {
+                size_t offset = bytes_.size();
+                size_t count = std::min<size_t>(header.bytes_ - offset, list_serialization::default_chunk_bytes);
+
+                bytes_.resize(offset + count);
+                list_serialization::read_exact(source_, bytes_.data() + offset, count);
+            }
+
+            const unsigned char *data = bytes_.data();
+            const unsigned char *end = data + bytes_.size();
+
+            values_.clear();
+
+            for (uint32_t i = 0; i < header.count_; ++i)
+                values_.push_back(ValueCodec<Type>::decode(data, end));
+
+            if (data != end)
+                throw std::runtime_error("Malformed list stream chunk");
+
+            out.insert(out.cend(), std::make_move_iterator(values_.begin()), std::make_move_iterator(values_.end()));
+        }
+
+        return true;
+    }
+
+private:
+    Source &source_;
+    bool finished_ = false;
+    std::vector<Slot> slots_;
+    std::vector<unsigned char> bytes_;
+    std::vector<Type> values_;
+};
+
+template <typename Type, typename Allocator, typename Sink>
+void serialize(const List<Type, Allocator> &list, Sink &sink,
+               size_t chunk_bytes = list_serialization::default_chunk_bytes)
+{
+    ListWriter<Type, Sink> writer(sink, chunk_bytes);
+
+    writer.write(list.begin(), list.end());
+    writer.finish();
+}
+
+template <typename Type, typename Allocator = std::allocator<Type>, typename Source>
+List<Type, Allocator> deserialize(Source &source, const Allocator &allocator = Allocator())
+{
+    ListReader<Type, Source, Allocator> reader(source);
+    List<Type, Allocator> result(allocator);
+
+    while (reader.read_chunk(result))
+        ;
+
+    return result;
+}
@@ -0,0 +1,139 @@
+#include <persistent/mapped_file.h>
+
+#include <cerrno>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+    [[noreturn]] void throw_errno(const char *what)
+    {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+}
+
+MappedFile::MappedFile(const std::string &path)
+{
+    descriptor_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+
+    if (descriptor_ == -1)
+        throw_errno("open");
+
+    struct stat status;
+
+    if (::fstat(descriptor_, &status) == -1)
+    {
+        ::close(descriptor_);
+        throw_errno("fstat");
+    }
+
+    try
+    {
+        map(static_cast<size_t>(status.st_size));
+    }
+    catch (...)
+    {
+        ::close(descriptor_);
+        throw;
+    }
+}
+
+MappedFile::MappedFile(MappedFile &&other) noexcept
+    : descriptor_(std::exchange(other.descriptor_, -1)),
+      data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0))
+{
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept
+{
+    if (this != &other)
+    {
+        unmap();
+
+        if (descriptor_ != -1)
+            ::close(descriptor_);
+
+        descriptor_ = std::exchange(other.descriptor_, -1);
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+    }
+
+    return *this;
+}
+
+MappedFile::~MappedFile()
+{
+    unmap();
+
+    if (descriptor_ != -1)
+        ::close(descriptor_);
+}
+
+void MappedFile::grow(size_t new_size)
+{
+    if (new_size <= size_)
+        return;
+
+    if (::ftruncate(descriptor_, static_cast<off_t>(new_size)) == -1)
+        throw_errno("ftruncate");
+
+    if (data_ == nullptr)
+    {
+        map(new_size);
+        return;
+    }
+
+#ifdef MREMAP_MAYMOVE
+    void *data = ::mremap(data_, size_, new_size, MREMAP_MAYMOVE);
+
+    if (data == MAP_FAILED)
+        throw_errno("mremap");
+
+    data_ = data;
+    size_ = new_size;
+#else
+    void *data = ::mmap(nullptr, new_size, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor_, 0);
+
+    if (data == MAP_FAILED)
+        throw_errno("mmap");
+
+    unmap();
+    data_ = data;
+    size_ = new_size;
+#endif
+}
+
+void MappedFile::flush()
+{
+    if (data_ != nullptr && ::msync(data_, size_, MS_SYNC) == -1)
+        throw_errno("msync");
+}
+
+void MappedFile::map(size_t size)
+{
+    if (size == 0)
+        return;
+
+    void *data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor_, 0);
+
+    if (data == MAP_FAILED)
+        throw_errno("mmap");
+
+    data_ = data;
+    size_ = size;
+}
+
+void MappedFile::unmap() noexcept
+{
+    if (data_ != nullptr)
+        ::munmap(data_, size_);
+
+    data_ = nullptr;
+    size_ = 0;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+// Read-write shared mapping of a whole file. The file is created when it
+// doesn't exist. Growing it may move the mapping, so pointers into it must
+// be recomputed from data() afterwards. Failures throw std::system_error.
+class MappedFile
+{
+public:
+    explicit MappedFile(const std::string &path);
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    MappedFile(MappedFile &&other) noexcept;
+    MappedFile &operator=(MappedFile &&other) noexcept;
+
+    ~MappedFile();
+
+    void *data() const noexcept
+    {
+        return data_;
+    }
+
+    size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    // Extends the file to new_size bytes, new bytes read as zero. Shrinking
+    // is not supported and leaves the file as it is.
+    void grow(size_t new_size);
+
+    // Writes dirty pages back to the file and waits for it.
+    void flush();
+
+private:
+    void map(size_t size);
+    void unmap() noexcept;
+
+private:
+    int descriptor_ = -1;
+    void *data_ = nullptr;
+    size_t size_ = 0;
+};
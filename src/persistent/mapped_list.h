@@ -0,0 +1,511 @@
+#pragma once
+
+#include <list/compact_list_iterator.h>
+#include <persistent/mapped_file.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// List stored in a memory-mapped file. Nodes link to each other by their
+// index in the file's node array, so the file is position independent:
+// opening an existing one maps it and the list is usable right away.
+// Growing the file may move the mapping, which invalidates references to
+// elements but not iterators. Writes reach the file when the kernel gets to
+// them or on flush(); a crash in the middle of an update can leave the file
+// inconsistent.
+template <typename Type>
+class MappedList
+{
+    static_assert(std::is_trivially_copyable_v<Type>, "Elements are stored as raw bytes in the file");
+
+private:
+    static constexpr uint64_t magic = 0x5453494c4150414dULL; // "MAPALIST"
+    static constexpr uint32_t layout_version = 1;
+    static constexpr uint32_t npos = UINT32_MAX;
+    static constexpr uint64_t initial_capacity = 64;
+
+    struct Header
+    {
+        uint64_t magic_;
+        uint32_t version_;
+        uint32_t node_size_;
+        uint32_t value_size_;
+        uint32_t value_alignment_;
+        uint64_t capacity_;
+        uint64_t size_;
+        uint32_t head_;
+        uint32_t tail_;
+        uint32_t free_list_;
+        uint32_t next_unused_;
+    };
+
+    struct Node
+    {
+        uint32_t prev_;
+        uint32_t next_;
+        Type value_;
+    };
+
+    // Keeps the node array cache line aligned in the file.
+    static constexpr size_t nodes_offset = (sizeof(Header) + 63) / 64 * 64;
+
+    static_assert(alignof(Node) <= 64, "Nodes have to be aligned inside the file");
+
+    using Storage = MappedList;
+    using Iter = CompactListIterator<MappedList, Type>;
+    using ConstIter = CompactListIterator<MappedList, const Type>;
+    using ReverseIter = std::reverse_iterator<Iter>;
+    using ConstReverseIter = std::reverse_iterator<ConstIter>;
+
+public: // Member types
+    using value_type = Type;
+    using iterator = Iter;
+    using const_iterator = ConstIter;
+
+public: // Special member functions
+    // Opens the list stored at path or creates an empty one. Throws
+    // std::runtime_error if the file holds a different layout.
+    explicit MappedList(const std::string &path) : file_(path)
+    {
+        if (file_.size() == 0)
+            initialize();
+        else
+            validate(path);
+    }
+
+    MappedList(const MappedList &) = delete;
+    MappedList &operator=(const MappedList &) = delete;
+
+    // A moved-from list holds no mapping, it may only be destroyed or
+    // assigned to.
+    MappedList(MappedList &&other) noexcept = default;
+    MappedList &operator=(MappedList &&other) noexcept = default;
+
+public: // Size-related methods
+    size_t size() const noexcept
+    {
+        return header().size_;
+    }
+
+    bool empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    size_t capacity() const noexcept
+    {
+        return header().capacity_;
+    }
+
+public: // Member access methods
+    Type &front() noexcept
+    {
+        return node(header().head_).value_;
+    }
+
+    const Type &front() const noexcept
+    {
+        return node(header().head_).value_;
+    }
+
+    Type &back() noexcept
+    {
+        return node(header().tail_).value_;
+    }
+
+    const Type &back() const noexcept
+    {
+        return node(header().tail_).value_;
+    }
+
+public: // Modifying methods
+    void push_front(const Type &value)
+    {
+        insert(cbegin(), value);
+    }
+
+    void push_back(const Type &value)
+    {
+        insert(cend(), value);
+    }
+
+    void pop_front() noexcept
+    {
+        erase_index(header().head_);
+    }
+
+    void pop_back() noexcept
+    {
+        erase_index(header().tail_);
+    }
+
+    void clear() noexcept
+    {
+        while (!empty())
+            pop_front();
+    }
+
+    void flush()
+    {
+        file_.flush();
+    }
+
+public: // Algorithms
+    void sort()
+    {
+        sort(std::less<Type>());
+    }
+
+    // Stable sort of the node indices, the nodes are relinked afterwards.
+    // If compare throws the list is left unchanged.
+    template <typename CmpFunc>
+    void sort(CmpFunc compare)
+    {
+        if (size() < 2)
+            return;
+
+        std::vector<uint32_t> order;
+        order.reserve(size());
+
+        for (uint32_t index = header().head_; index != npos; index = node(index).next_)
+            order.push_back(index);
+
+        std::stable_sort(order.begin(), order.end(), [this, &compare](uint32_t lhs, uint32_t rhs)
+                         { return compare(node(lhs).value_, node(rhs).value_); });
+
+        uint32_t prev = npos;
+
+        for (uint32_t index : order)
+        {
+            node(index).prev_ = prev;
+
+            if (prev != npos)
+                node(prev).next_ = index;
+
+            prev = index;
+        }
+
+        node(prev).next_ = npos;
+        header().head_ = order.front();
+        header().tail_ = prev;
+    }
+
+    void reverse() noexcept
+    {
+        for (uint32_t index = header().head_; index != npos;)
+        {
+            Node &current = node(index);
+
+            std::swap(current.prev_, current.next_);
+            index = current.prev_;
+        }
+
+        std::swap(header().head_, header().tail_);
+    }
+
+    // Moves [begin, end) in front of position. Within one file this only
+    // relinks nodes, from another file the values are copied over.
+    void splice(ConstIter position, MappedList &other, ConstIter begin, ConstIter end)
+    {
+        if (begin == end)
+            return;
+
+        if (this != &other)
+        {
+            while (begin != end)
+            {
+                insert(position, *begin);
+                begin = other.erase(begin);
+            }
+
+            return;
+        }
+
+        uint32_t first = begin.index_;
+        uint32_t last = prev_index(end.index_);
+
+        if (position.index_ == end.index_)
+            return;
+
+        unlink_range(first, last);
+        link_range_before(position.index_, first, last);
+    }
+
+    void splice(ConstIter position, MappedList &other)
+    {
+        if (this != &other)
+            splice(position, other, other.cbegin(), other.cend());
+    }
+
+    void splice(ConstIter position, MappedList &other, ConstIter it)
+    {
+        splice(position, other, it, std::next(it));
+    }
+
+public: // Iterator-related methods
+    Iter insert(ConstIter position, const Type &value)
+    {
+        // value may live in this file, which allocate_index() can remap.
+        const Type copy = value;
+        uint32_t index = allocate_index();
+
+        node(index).value_ = copy;
+        link_range_before(position.index_, index, index);
+        ++header().size_;
+
+        return Iter(this, index);
+    }
+
+    Iter erase(ConstIter position) noexcept
+    {
+        uint32_t next = node(position.index_).next_;
+
+        erase_index(position.index_);
+
+        return Iter(this, next);
+    }
+
+public: // Fabric methods
+    Iter begin() noexcept
+    {
+        return Iter(this, header().head_);
+    }
+
+    Iter end() noexcept
+    {
+        return Iter(this, npos);
+    }
+
+    ConstIter begin() const noexcept
+    {
+        return cbegin();
+    }
+
+    ConstIter end() const noexcept
+    {
+        return cend();
+    }
+
+    ConstIter cbegin() const noexcept
+    {
+        return ConstIter(this, header().head_);
+    }
+
+    ConstIter cend() const noexcept
+    {
+        return ConstIter(this, npos);
+    }
+
+    ReverseIter rbegin() noexcept
+    {
+        return ReverseIter(end());
+    }
+
+    ReverseIter rend() noexcept
+    {
+        return ReverseIter(begin());
+    }
+
+    ConstReverseIter crbegin() const noexcept
+    {
+        return ConstReverseIter(cend());
+    }
+
+    ConstReverseIter crend() const noexcept
+    {
+        return ConstReverseIter(cbegin());
+    }
+
+private: // Internal logic
+    Header &header() noexcept
+    {
+        return *static_cast<Header *>(file_.data());
+    }
+
+    const Header &header() const noexcept
+    {
+        return *static_cast<const Header *>(file_.data());
+    }
+
+    Node &node(uint32_t index) noexcept
+    {
+        return reinterpret_cast<Node *>(static_cast<char *>(file_.data()) + nodes_offset)[index];
+    }
+
+    const Node &node(uint32_t index) const noexcept
+    {
+        return reinterpret_cast<const Node *>(static_cast<const char *>(file_.data()) + nodes_offset)[index];
+    }
+
+    Type *value(uint32_t index) noexcept
+    {
+        return &node(index).value_;
+    }
+
+    const Type *value(uint32_t index) const noexcept
+    {
+        return &node(index).value_;
+    }
+
+    MappedList *storage() noexcept
+    {
+        return this;
+    }
+
+    const MappedList *storage() const noexcept
+    {
+        return this;
+    }
+
+    uint32_t next_index(uint32_t index) const noexcept
+    {
+        return node(index).next_;
+    }
+
+    uint32_t prev_index(uint32_t index) const noexcept
+    {
+        return index == npos ? header().tail_ : node(index).prev_;
+    }
+
+    static size_t file_size(uint64_t capacity) noexcept
+    {
+        return nodes_offset + capacity * sizeof(Node);
+    }
+
+    void initialize()
+    {
+        file_.grow(file_size(initial_capacity));
+
+        Header &created = header();
+
+        created.version_ = layout_version;
+        created.node_size_ = sizeof(Node);
+        created.value_size_ = sizeof(Type);
+        created.value_alignment_ = alignof(Type);
+        created.capacity_ = initial_capacity;
+        created.size_ = 0;
+        created.head_ = created.tail_ = created.free_list_ = npos;
+        created.next_unused_ = 0;
+
+        // Written last, so a file that was cut short is never accepted.
+        created.magic_ = magic;
+    }
+
+    void validate(const std::string &path) const
+    {
+        if (file_.size() < sizeof(Header))
+            throw std::runtime_error(path + " is too small to hold a mapped list");
+
+        const Header &stored = header();
+
+        if (stored.magic_ != magic)
+            throw std::runtime_error(path + " doesn't hold a mapped list");
+
+        if (stored.version_ != layout_version)
+            throw std::runtime_error(path + " has layout version " + std::to_string(stored.version_) +
+                                     ", expected " + std::to_string(layout_version));
+
+        if (stored.node_size_ != sizeof(Node) || stored.value_size_ != sizeof(Type) ||
+            stored.value_alignment_ != alignof(Type))
+            throw std::runtime_error(path + " holds elements of a different type");
+
+        if (stored.capacity_ == 0 || stored.capacity_ > npos)
+            throw std::runtime_error(path + " has an invalid capacity");
+
+        if (file_.size() < file_size(stored.capacity_))
+            throw std::runtime_error(path + " is shorter than its node array");
+
+        // Every link followed from the header has to stay inside the nodes
+        // handed out so far.
+        auto is_link = [&stored](uint32_t index) { return index == npos || index < stored.next_unused_; };
+
+        if (stored.next_unused_ > stored.capacity_ || stored.size_ > stored.next_unused_ || !is_link(stored.head_) ||
+            !is_link(stored.tail_) || !is_link(stored.free_list_) ||
+            (stored.head_ == npos) != (stored.size_ == 0) || (stored.tail_ == npos) != (stored.size_ == 0))
+            throw std::runtime_error(path + " has a corrupt header");
+    }
+
+    uint32_t allocate_index()
+    {
+        Header *current = &header();
+
+        if (current->free_list_ != npos)
+        {
+            uint32_t index = current->free_list_;
+            current->free_list_ = node(index).next_;
+
+            return index;
+        }
+
+        if (current->next_unused_ == current->capacity_)
+        {
+            uint64_t capacity = std::min<uint64_t>(current->capacity_ * 2, npos);
+
+            if (capacity == current->capacity_)
+                throw std::length_error("MappedList ran out of 32-bit indices");
+
+            file_.grow(file_size(capacity));
+
+            current = &header();
+            current->capacity_ = capacity;
+        }
+
+        return current->next_unused_++;
+    }
+
+    void erase_index(uint32_t index) noexcept
+    {
+        unlink_range(index, index);
+
+        node(index).next_ = header().free_list_;
+        header().free_list_ = index;
+        --header().size_;
+    }
+
+    void link_range_before(uint32_t position, uint32_t first, uint32_t last) noexcept
+    {
+        uint32_t prev = prev_index(position);
+
+        node(first).prev_ = prev;
+        node(last).next_ = position;
+
+        if (prev == npos)
+            header().head_ = first;
+        else
+            node(prev).next_ = first;
+
+        if (position == npos)
+            header().tail_ = last;
+        else
+            node(position).prev_ = last;
+    }
+
+    void unlink_range(uint32_t first, uint32_t last) noexcept
+    {
+        uint32_t prev = node(first).prev_;
+        uint32_t next = node(last).next_;
+
+        if (prev == npos)
+            header().head_ = next;
+        else
+            node(prev).next_ = next;
+
+        if (next == npos)
+            header().tail_ = prev;
+        else
+            node(next).prev_ = prev;
+    }
+
+private:
+    template <class, typename>
+    friend class CompactListIterator;
+
+private:
+    MappedFile file_;
+};
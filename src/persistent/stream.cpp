@@ -0,0 +1,129 @@
+#include <persistent/stream.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <system_error>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace
+{
+    [[noreturn]] void throw_errno(const char *what)
+    {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+
+    int open_file(const std::string &path, int flags)
+    {
+        int descriptor = ::open(path.c_str(), flags | O_CLOEXEC, 0644);
+
+        if (descriptor == -1)
+            throw_errno("open");
+
+        return descriptor;
+    }
+}
+
+FileSink::FileSink(const std::string &path) : descriptor_(open_file(path, O_WRONLY | O_CREAT | O_TRUNC))
+{
+}
+
+FileSink::~FileSink()
+{
+    ::close(descriptor_);
+}
+
+void FileSink::write(const void *data, size_t size)
+{
+    iovec part{const_cast<void *>(data), size};
+
+    writev(&part, 1);
+}
+
+// Short writes leave the parts adjusted in place and are resumed until
+// everything is out.
+void FileSink::writev(iovec *parts, int count)
+{
+    while (count > 0)
+    {
+        ssize_t written = ::writev(descriptor_, parts, std::min(count, IOV_MAX));
+
+        if (written == -1)
+        {
+            if (errno == EINTR)
+                continue;
+
+            throw_errno("writev");
+        }
+
+        size_t remaining = static_cast<size_t>(written);
+
+        while (count > 0 && remaining >= parts->iov_len)
+        {
+            remaining -= parts->iov_len;
+            ++parts;
+            --count;
+        }
+
+        if (count > 0)
+        {
+            parts->iov_base = static_cast<char *>(parts->iov_base) + remaining;
+            parts->iov_len -= remaining;
+        }
+    }
+}
+
+void FileSink::sync()
+{
+    if (::fsync(descriptor_) == -1)
+        throw_errno("fsync");
+}
+
+FileSource::FileSource(const std::string &path) : descriptor_(open_file(path, O_RDONLY))
+{
+}
+
+FileSource::~FileSource()
+{
+    ::close(descriptor_);
+}
+
+size_t FileSource::read(void *data, size_t size)
+{
+    size_t total = 0;
+
+    while (total < size)
+    {
+        ssize_t count = ::read(descriptor_, static_cast<char *>(data) + total, size - total);
+
+        if (count == -1)
+        {
+            if (errno == EINTR)
+                continue;
+
+            throw_errno("read");
+        }
+
+        if (count == 0)
+            break;
+
+        total += static_cast<size_t>(count);
+    }
+
+    return total;
+}
+
+size_t MemorySource::read(void *data, size_t size)
+{
+    size_t count = std::min(size, size_ - position_);
+
+    if (count != 0)
+        std::memcpy(data, data_ + position_, count);
+
+    position_ += count;
+
+    return count;
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <sys/uio.h>
+
+// Byte sinks and sources for the list serializer. A sink provides
+// write(data, size) and may provide writev(iovec *, count) for gathered
+// writes; a source provides read(data, size), which returns fewer bytes
+// than asked for only at the end of the stream. Failures throw
+// std::system_error.
+
+// Unbuffered sink writing to a file, which is created or truncated. Callers
+// are expected to hand it large blocks; gathered writes go out with writev.
+class FileSink
+{
+public:
+    explicit FileSink(const std::string &path);
+
+    FileSink(const FileSink &) = delete;
+    FileSink &operator=(const FileSink &) = delete;
+
+    ~FileSink();
+
+    void write(const void *data, size_t size);
+    void writev(iovec *parts, int count);
+
+    // Waits until the written data reaches the disk.
+    void sync();
+
+private:
+    int descriptor_ = -1;
+};
+
+// Unbuffered source reading a file from the beginning.
+class FileSource
+{
+public:
+    explicit FileSource(const std::string &path);
+
+    FileSource(const FileSource &) = delete;
+    FileSource &operator=(const FileSource &) = delete;
+
+    ~FileSource();
+
+    size_t read(void *data, size_t size);
+
+private:
+    int descriptor_ = -1;
+};
+
+// Sink appending to an in-memory buffer.
+class MemorySink
+{
+public:
+    void write(const void *data, size_t size)
+    {
+        const unsigned char *bytes = static_cast<const unsigned char *>(data);
+
+        buffer_.insert(buffer_.end(), bytes, bytes + size);
+    }
+
+    const std::vector<unsigned char> &buffer() const noexcept
+    {
+        return buffer_;
+    }
+
+private:
+    std::vector<unsigned char> buffer_;
+};
+
+// Source reading from memory it doesn't own.
+class MemorySource
+{
+public:
+    MemorySource(const void *data, size_t size)
+        : data_(static_cast<const unsigned char *>(data)), size_(size)
+    {
+    }
+
+    explicit MemorySource(const std::vector<unsigned char> &buffer) : MemorySource(buffer.data(), buffer.size())
+    {
+    }
+
+    size_t read(void *data, size_t size);
+
+private:
+    const unsigned char *data_;
+    size_t size_;
+    size_t position_ = 0;
+};
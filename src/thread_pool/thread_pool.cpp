@@ -0,0 +1,77 @@
+#include <thread_pool/thread_pool.h>
+
+ThreadPool::ThreadPool(size_t threads)
+{
+    if (threads == 0)
+        threads = 1;
+
+    workers_.reserve(threads);
+
+    for (size_t i = 0; i < threads; ++i)
+        workers_.emplace_back([this] { worker_loop(); });
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard lock(mutex_);
+        stopping_ = true;
+    }
+
+    condition_.notify_all();
+
+    for (std::thread &worker : workers_)
+        worker.join();
+}
+
+ThreadPool &ThreadPool::shared()
+{
+    static ThreadPool pool(std::thread::hardware_concurrency());
+
+    return pool;
+}
+
+size_t ThreadPool::size() const noexcept
+{
+    return workers_.size();
+}
+
+bool ThreadPool::run_pending_task()
+{
+    std::function<void()> task;
+
+    {
+        std::lock_guard lock(mutex_);
+
+        if (tasks_.empty())
+            return false;
+
+        task = std::move(tasks_.front());
+        tasks_.pop();
+    }
+
+    task();
+
+    return true;
+}
+
+void ThreadPool::worker_loop()
+{
+    while (true)
+    {
+        std::function<void()> task;
+
+        {
+            std::unique_lock lock(mutex_);
+            condition_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+
+            if (tasks_.empty())
+                return;
+
+            task = std::move(tasks_.front());
+            tasks_.pop();
+        }
+
+        task();
+    }
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+class ThreadPool
+{
+public:
+    explicit ThreadPool(size_t threads);
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+    ~ThreadPool();
+
+    // Process-wide pool with one worker per hardware thread, created on
+    // first use, so repeated parallel calls don't pay for thread startup.
+    static ThreadPool &shared();
+
+    size_t size() const noexcept;
+
+    // Runs one queued task on the calling thread. Returns false when there
+    // was nothing to run.
+    bool run_pending_task();
+
+    // Waits for a task submitted to this pool, running queued tasks in the
+    // meantime instead of blocking. This keeps the caller busy and lets
+    // tasks wait for other tasks of the same pool without deadlocking.
+    template <typename Result>
+    void wait(const std::future<Result> &result)
+    {
+        while (result.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        {
+            if (!run_pending_task())
+                result.wait();
+        }
+    }
+
+    template <typename Func>
+    std::future<std::invoke_result_t<Func>> submit(Func &&task)
+    {
+        using Result = std::invoke_result_t<Func>;
+
+        auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<Func>(task));
+        std::future<Result> result = packaged->get_future();
+
+        {
+            std::lock_guard lock(mutex_);
+            tasks_.emplace([packaged] { (*packaged)(); });
+        }
+
+        condition_.notify_one();
+
+        return result;
+    }
+
+private:
+    void worker_loop();
+
+private:
+    std::vector<std::thread> workers_;
+    std::queue<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    bool stopping_ = false;
+};
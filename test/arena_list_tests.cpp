@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+
+#include "../src/lifetime_helper/lifetime_helper.h"
+#include "list/arena_list.h"
+#include <list>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+template <class ListType>
+std::vector<typename ListType::value_type> values_of(const ListType &l)
+{
+    return {l.begin(), l.end()};
+}
+
+} // namespace
+
+TEST(ArenaListTests, PushedObjectsArePlacedInRightOrder)
+{
+    ArenaList<int> l;
+    std::list<int> reference;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        l.push_front(i);
+        l.push_back(-i);
+        reference.push_front(i);
+        reference.push_back(-i);
+    }
+
+    ASSERT_EQ(reference.size(), l.size());
+    EXPECT_TRUE(std::equal(reference.begin(), reference.end(), l.begin()));
+    EXPECT_TRUE(std::equal(reference.crbegin(), reference.crend(), l.crbegin()));
+
+    auto it = l.insert(std::next(l.cbegin(), 10), 12345);
+    auto ref_it = reference.insert(std::next(reference.cbegin(), 10), 12345);
+
+    EXPECT_EQ(*ref_it, *it);
+    EXPECT_EQ(*reference.erase(ref_it), *l.erase(it));
+    EXPECT_TRUE(std::equal(reference.begin(), reference.end(), l.begin()));
+}
+
+TEST(ArenaListTests, HandlesSurviveGrowthAndCompaction)
+{
+    ArenaList<std::string> l;
+    std::vector<ArenaList<std::string>::Handle> handles;
+
+    for (int i = 0; i < 500; ++i)
+        handles.push_back(i % 2 == 0 ? l.push_back(std::to_string(i)) : l.push_front(std::to_string(i)));
+
+    for (int i = 0; i < 500; i += 3)
+        l.erase(handles[i]);
+
+    EXPECT_FALSE(l.contains(handles[0]));
+    EXPECT_TRUE(l.contains(handles[1]));
+    EXPECT_EQ(l.end(), l.find(handles[3]));
+
+    std::vector<std::string> before = values_of(l);
+
+    l.compact();
+
+    EXPECT_EQ(before, values_of(l));
+    EXPECT_EQ(l.size(), l.arena_size());
+
+    for (int i = 0; i < 500; ++i)
+    {
+        if (i % 3 == 0)
+        {
+            EXPECT_FALSE(l.contains(handles[i]));
+            continue;
+        }
+
+        ASSERT_TRUE(l.contains(handles[i]));
+        EXPECT_EQ(std::to_string(i), l[handles[i]]);
+        EXPECT_EQ(std::to_string(i), *l.find(handles[i]));
+    }
+
+    auto reused = l.push_back("reused");
+
+    EXPECT_NE(handles[0], reused);
+    EXPECT_FALSE(l.contains(handles[0]));
+    EXPECT_EQ(reused, l.handle(std::prev(l.cend())));
+}
+
+TEST(ArenaListTests, CompactionLaysNodesOutInTraversalOrder)
+{
+    ArenaList<int> l;
+    std::mt19937 generator(1);
+
+    for (int i = 0; i < 1000; ++i)
+        l.push_back(static_cast<int>(generator() % 1000));
+
+    for (int i = 0; i < 300; ++i)
+        l.erase(std::next(l.cbegin(), generator() % l.size()));
+
+    l.sort();
+    l.compact();
+
+    EXPECT_TRUE(std::is_sorted(l.begin(), l.end()));
+
+    const int *previous = &l.front();
+
+    for (auto it = std::next(l.cbegin()); it != l.cend(); ++it)
+    {
+        EXPECT_LT(reinterpret_cast<const char *>(previous), reinterpret_cast<const char *>(&*it));
+        previous = &*it;
+    }
+}
+
+TEST(ArenaListTests, CopyKeepsHandlesValid)
+{
+    ArenaList<int> l{1, 2, 3, 4, 5};
+    auto handle = l.push_back(6);
+
+    l.pop_front();
+    l.reverse();
+
+    ArenaList<int> copy(l);
+
+    EXPECT_EQ(values_of(l), values_of(copy));
+    EXPECT_EQ(6, copy[handle]);
+    EXPECT_EQ(copy.begin(), copy.find(handle));
+
+    copy.erase(handle);
+
+    EXPECT_FALSE(copy.contains(handle));
+    EXPECT_TRUE(l.contains(handle));
+}
+
+TEST(ArenaListTests, ObjectsAreConstructedAndDestructedCorrectly)
+{
+    {
+        ArenaList<LifetimeHelper> l;
+
+        for (int i = 0; i < 100; ++i)
+            l.emplace_back();
+
+        for (int i = 0; i < 50; ++i)
+            l.erase(std::next(l.cbegin(), i));
+
+        EXPECT_EQ(50, LifetimeHelper::get_alive_count());
+
+        l.compact();
+        l.emplace_back(l.front());
+
+        ArenaList<LifetimeHelper> copy(l);
+
+        EXPECT_EQ(102, LifetimeHelper::get_alive_count());
+
+        copy.clear();
+
+        EXPECT_EQ(51, LifetimeHelper::get_alive_count());
+    }
+
+    EXPECT_EQ(0, LifetimeHelper::get_alive_count());
+}
@@ -0,0 +1,191 @@
+#include <gtest/gtest.h>
+
+#include "../src/lifetime_helper/lifetime_helper.h"
+#include "list/compact_list.h"
+#include <list>
+#include <vector>
+
+namespace
+{
+
+template <class ListType>
+std::vector<typename ListType::value_type> values_of(const ListType &l)
+{
+    return {l.begin(), l.end()};
+}
+
+} // namespace
+
+TEST(CompactListTests, NodesUseThirtyTwoBitLinks)
+{
+    EXPECT_EQ(12, sizeof(CompactNodeArena<uint32_t>::Node));
+    EXPECT_EQ(16, sizeof(CompactNodeArena<uint64_t>::Node));
+}
+
+TEST(CompactListTests, PushedObjectsArePlacedInRightOrder)
+{
+    CompactList<int> l;
+    std::list<int> reference;
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        l.push_front(i);
+        l.push_back(-i);
+        reference.push_front(i);
+        reference.push_back(-i);
+    }
+
+    ASSERT_EQ(reference.size(), l.size());
+    EXPECT_TRUE(std::equal(reference.begin(), reference.end(), l.begin()));
+    EXPECT_TRUE(std::equal(reference.crbegin(), reference.crend(), l.crbegin()));
+
+    for (int i = 0; i < 100; ++i)
+    {
+        l.pop_front();
+        l.pop_back();
+        reference.pop_front();
+        reference.pop_back();
+    }
+
+    EXPECT_EQ(reference.front(), l.front());
+    EXPECT_EQ(reference.back(), l.back());
+    EXPECT_EQ(reference.size(), l.size());
+}
+
+TEST(CompactListTests, ArenaRecyclesFreedNodes)
+{
+    auto arena = std::make_shared<CompactList<int>::Arena>();
+    CompactList<int> l(arena);
+
+    for (int i = 0; i < 100; ++i)
+        l.push_back(i);
+
+    size_t capacity = arena->capacity();
+
+    for (int round = 0; round < 10; ++round)
+    {
+        auto it = l.insert(std::next(l.cbegin(), 50), -1);
+        EXPECT_EQ(-1, *it);
+
+        l.erase(it);
+        l.pop_front();
+        l.push_back(round);
+    }
+
+    EXPECT_EQ(100, arena->used());
+    EXPECT_EQ(capacity, arena->capacity());
+
+    l.clear();
+
+    EXPECT_EQ(0, arena->used());
+}
+
+TEST(CompactListTests, SpliceWithinOneArenaRelinksNodes)
+{
+    auto arena = std::make_shared<CompactList<int>::Arena>();
+    CompactList<int> source(arena);
+    CompactList<int> destination(arena);
+
+    for (int i = 0; i < 10; ++i)
+        source.push_back(i);
+
+    destination.push_back(100);
+    destination.push_back(200);
+
+    const int *moved_element = &*std::next(source.begin(), 2);
+
+    destination.splice(std::next(destination.cbegin()), source, std::next(source.cbegin(), 2),
+                       std::next(source.cbegin(), 5));
+
+    EXPECT_EQ((std::vector<int>{0, 1, 5, 6, 7, 8, 9}), values_of(source));
+    EXPECT_EQ((std::vector<int>{100, 2, 3, 4, 200}), values_of(destination));
+    EXPECT_EQ(moved_element, &*std::next(destination.begin()));
+
+    destination.splice(destination.cbegin(), destination, std::prev(destination.cend()));
+    destination.splice(destination.cend(), source, source.cbegin());
+    destination.splice(destination.cend(), source);
+
+    EXPECT_TRUE(source.empty());
+    EXPECT_EQ((std::vector<int>{200, 100, 2, 3, 4, 0, 1, 5, 6, 7, 8, 9}), values_of(destination));
+    EXPECT_EQ(12, arena->used());
+}
+
+TEST(CompactListTests, IteratorsStayValidWhenSplicedIntoAnotherList)
+{
+    auto arena = std::make_shared<CompactList<int>::Arena>();
+    CompactList<int> destination(arena);
+
+    destination.push_back(0);
+
+    auto it = destination.end();
+
+    {
+        CompactList<int> source(arena);
+
+        for (int i = 1; i <= 3; ++i)
+            source.push_back(i);
+
+        it = source.begin();
+        destination.splice(destination.cend(), source);
+    }
+
+    std::vector<int> walked;
+
+    for (; it != destination.end(); ++it)
+        walked.push_back(*it);
+
+    EXPECT_EQ((std::vector<int>{1, 2, 3}), walked);
+    EXPECT_EQ(3, *std::prev(destination.end()));
+}
+
+TEST(CompactListTests, SpliceBetweenArenasMovesElements)
+{
+    CompactList<int> source{1, 2, 3, 4};
+    CompactList<int> destination{10, 20};
+
+    destination.splice(std::next(destination.cbegin()), source, std::next(source.cbegin()), source.cend());
+    destination.splice(destination.cbegin(), source);
+
+    EXPECT_TRUE(source.empty());
+    EXPECT_EQ(0, source.get_arena()->used());
+    EXPECT_EQ((std::vector<int>{1, 10, 2, 3, 4, 20}), values_of(destination));
+}
+
+TEST(CompactListTests, SortAndReverseWorkCorrectly)
+{
+    CompactList<int> l{432, 66, 123, 778, 1, 745, 7, 1, 6543, 78, 345, 777, 124, 55, 11, 44, 53};
+    std::vector<int> expected = values_of(l);
+
+    l.sort();
+    std::sort(expected.begin(), expected.end());
+
+    EXPECT_EQ(expected, values_of(l));
+
+    l.reverse();
+
+    EXPECT_TRUE(std::equal(expected.rbegin(), expected.rend(), l.begin()));
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(), l.crbegin()));
+}
+
+TEST(CompactListTests, ObjectsAreConstructedAndDestructedCorrectly)
+{
+    {
+        CompactList<LifetimeHelper> l;
+
+        for (int i = 0; i < 10; ++i)
+            l.emplace_back();
+
+        CompactList<LifetimeHelper> copy(l);
+        CompactList<LifetimeHelper> moved(std::move(l));
+
+        EXPECT_EQ(20, LifetimeHelper::get_alive_count());
+        EXPECT_EQ(20, copy.get_arena()->used());
+
+        moved.erase(moved.cbegin());
+        copy = moved;
+
+        EXPECT_EQ(18, LifetimeHelper::get_alive_count());
+    }
+
+    EXPECT_EQ(0, LifetimeHelper::get_alive_count());
+}
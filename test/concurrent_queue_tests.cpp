@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+
+#include "../src/lifetime_helper/lifetime_helper.h"
+#include "concurrent/concurrent_queue.h"
+#include <thread>
+#include <vector>
+
+TEST(ConcurrentQueueTests, KeepsFifoOrderInOneThread)
+{
+    ConcurrentQueue<int> queue;
+    ASSERT_TRUE(queue.empty());
+
+    for (int i = 0; i < 10; ++i)
+        queue.push_back(i);
+
+    EXPECT_FALSE(queue.empty());
+
+    for (int i = 0; i < 10; ++i)
+        EXPECT_EQ(i, queue.try_pop_front());
+
+    EXPECT_FALSE(queue.try_pop_front().has_value());
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(ConcurrentQueueTests, RangesArePushedAndPoppedInBatches)
+{
+    ConcurrentQueue<std::string> queue;
+    std::vector<std::string> values{"a", "b", "c", "d", "e"};
+
+    queue.push_back("first");
+    queue.push_range(values.begin(), values.end());
+    queue.push_back("last");
+
+    std::vector<std::string> popped;
+
+    EXPECT_EQ(4, queue.pop_batch(std::back_inserter(popped), 4));
+    EXPECT_EQ(3, queue.pop_batch(std::back_inserter(popped), 10));
+    EXPECT_EQ(0, queue.pop_batch(std::back_inserter(popped), 10));
+
+    std::vector<std::string> expected{"first", "a", "b", "c", "d", "e", "last"};
+    EXPECT_EQ(expected, popped);
+}
+
+TEST(ConcurrentQueueTests, ObjectsAreConstructedAndDestructedCorrectly)
+{
+    {
+        ConcurrentQueue<LifetimeHelper> queue;
+
+        for (int i = 0; i < 10; ++i)
+            queue.emplace_back();
+
+        EXPECT_EQ(10, LifetimeHelper::get_alive_count());
+
+        for (int i = 0; i < 4; ++i)
+            queue.try_pop_front();
+
+        EXPECT_EQ(6, LifetimeHelper::get_alive_count());
+    }
+
+    EXPECT_EQ(0, LifetimeHelper::get_alive_count());
+}
+
+TEST(ConcurrentQueueTests, EveryValueIsPoppedExactlyOnceUnderContention)
+{
+    constexpr int producers = 4;
+    constexpr int consumers = 4;
+    constexpr int per_producer = 50000;
+
+    ConcurrentQueue<std::pair<int, int>> queue;
+    std::vector<std::vector<std::pair<int, int>>> received(consumers);
+    std::atomic<int> done_producers = 0;
+    std::vector<std::thread> threads;
+
+    for (int p = 0; p < producers; ++p)
+    {
+        threads.emplace_back([&queue, &done_producers, p]
+        {
+            for (int i = 0; i < per_producer; i += 10)
+            {
+                std::vector<std::pair<int, int>> batch;
+
+                for (int j = i; j < i + 10; ++j)
+                    batch.emplace_back(p, j);
+
+                if (i % 20 == 0)
+                    queue.push_range(batch.begin(), batch.end());
+                else
+                    for (const auto &value : batch)
+                        queue.push_back(value);
+            }
+
+            ++done_producers;
+        });
+    }
+
+    for (int c = 0; c < consumers; ++c)
+    {
+        threads.emplace_back([&queue, &done_producers, &received, c]
+        {
+            while (true)
+            {
+                bool finished = done_producers == producers;
+
+                if (c % 2 == 0)
+                {
+                    if (auto value = queue.try_pop_front())
+                        received[c].push_back(*value);
+                    else if (finished)
+                        break;
+                }
+                else if (queue.pop_batch(std::back_inserter(received[c]), 16) == 0 && finished)
+                {
+                    break;
+                }
+            }
+        });
+    }
+
+    for (std::thread &thread : threads)
+        thread.join();
+
+    std::vector<std::vector<int>> counts(producers, std::vector<int>(per_producer, 0));
+
+    for (const auto &values : received)
+    {
+        std::vector<int> last_seen(producers, -1);
+
+        for (const auto &[producer, number] : values)
+        {
+            ++counts[producer][number];
+
+            EXPECT_LT(last_seen[producer], number);
+            last_seen[producer] = number;
+        }
+    }
+
+    for (const auto &producer_counts : counts)
+        for (int count : producer_counts)
+            ASSERT_EQ(1, count);
+}
@@ -0,0 +1,237 @@
+#include <gtest/gtest.h>
+
+#include "list/intrusive_list.h"
+#include <list>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+struct Item
+{
+    Item(int value = 0) : value_(value)
+    {
+    }
+
+    bool operator<(const Item &other) const
+    {
+        return value_ < other.value_;
+    }
+
+    virtual ~Item() = default;
+
+    int value_;
+    IntrusiveListHook hook_;
+    IntrusiveListHook other_hook_;
+};
+
+using ItemList = IntrusiveList<Item, &Item::hook_>;
+using OtherItemList = IntrusiveList<Item, &Item::other_hook_>;
+
+std::vector<int> values_of(const ItemList &l)
+{
+    std::vector<int> result;
+
+    for (const Item &item : l)
+        result.push_back(item.value_);
+
+    return result;
+}
+
+} // namespace
+
+TEST(IntrusiveListTests, LinksObjectsInPlace)
+{
+    std::vector<Item> items{1, 2, 3, 4, 5};
+    ItemList l;
+
+    for (Item &item : items)
+        l.push_back(item);
+
+    ASSERT_EQ(5, l.size());
+    EXPECT_EQ(&items.front(), &l.front());
+    EXPECT_EQ(&items.back(), &l.back());
+    EXPECT_EQ(&items[2], &*std::next(l.begin(), 2));
+    EXPECT_EQ(&items[3], &*l.iterator_to(items[3]));
+
+    l.pop_front();
+    l.pop_back();
+
+    EXPECT_FALSE(items.front().hook_.is_linked());
+    EXPECT_EQ((std::vector<int>{2, 3, 4}), values_of(l));
+
+    l.push_front(items.back());
+
+    EXPECT_EQ((std::vector<int>{5, 2, 3, 4}), values_of(l));
+    EXPECT_TRUE(std::equal(l.crbegin(), l.crend(), std::vector<Item>{4, 3, 2, 5}.begin(),
+                           [](const Item &lhs, const Item &rhs) { return lhs.value_ == rhs.value_; }));
+}
+
+TEST(IntrusiveListTests, ObjectCanBeInSeveralListsThroughDifferentHooks)
+{
+    std::vector<Item> items{1, 2, 3};
+    ItemList l;
+    OtherItemList other;
+
+    for (Item &item : items)
+    {
+        l.push_back(item);
+        other.push_front(item);
+    }
+
+    EXPECT_EQ(1, l.front().value_);
+    EXPECT_EQ(3, other.front().value_);
+
+    l.erase(l.iterator_to(items[1]));
+
+    EXPECT_FALSE(items[1].hook_.is_linked());
+    EXPECT_TRUE(items[1].other_hook_.is_linked());
+    EXPECT_EQ(3, other.size());
+}
+
+TEST(IntrusiveListTests, InsertAndEraseInTheMiddle)
+{
+    std::vector<Item> items(20);
+    ItemList l;
+    std::list<int> reference;
+
+    for (int i = 0; i < 20; ++i)
+    {
+        items[i].value_ = i;
+
+        auto inserted = l.insert(std::next(l.cbegin(), l.size() / 2), items[i]);
+        reference.insert(std::next(reference.cbegin(), reference.size() / 2), i);
+
+        EXPECT_EQ(i, inserted->value_);
+    }
+
+    ASSERT_TRUE(std::equal(reference.begin(), reference.end(), values_of(l).begin()));
+
+    auto next = l.erase(std::next(l.cbegin(), 3), std::next(l.cbegin(), 8));
+    auto ref_next = reference.erase(std::next(reference.cbegin(), 3), std::next(reference.cbegin(), 8));
+
+    EXPECT_EQ(*ref_next, next->value_);
+    EXPECT_EQ(15, l.size());
+    EXPECT_TRUE(std::equal(reference.begin(), reference.end(), values_of(l).begin()));
+}
+
+TEST(IntrusiveListTests, SpliceKeepsSizesInSync)
+{
+    std::vector<Item> items{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    ItemList source;
+    ItemList destination;
+
+    for (int i = 0; i < 7; ++i)
+        source.push_back(items[i]);
+
+    for (int i = 7; i < 10; ++i)
+        destination.push_back(items[i]);
+
+    destination.splice(std::next(destination.cbegin()), source, std::next(source.cbegin()), std::next(source.cbegin(), 4));
+
+    EXPECT_EQ(4, source.size());
+    EXPECT_EQ(6, destination.size());
+    EXPECT_EQ((std::vector<int>{7, 1, 2, 3, 8, 9}), values_of(destination));
+
+    destination.splice(destination.cbegin(), destination, std::prev(destination.cend()));
+    destination.splice(destination.cend(), source);
+
+    EXPECT_TRUE(source.empty());
+    EXPECT_EQ((std::vector<int>{9, 7, 1, 2, 3, 8, 0, 4, 5, 6}), values_of(destination));
+}
+
+TEST(IntrusiveListTests, SortIsStableAndMergeKeepsOrder)
+{
+    std::mt19937 generator(3);
+    std::vector<Item> items(1000);
+    std::vector<Item> more{3, 150000, 600000};
+    ItemList l;
+
+    for (size_t i = 0; i < items.size(); ++i)
+    {
+        items[i].value_ = static_cast<int>(generator() % 50) * 10000 + static_cast<int>(i);
+        l.push_back(items[i]);
+    }
+
+    l.sort([](const Item &lhs, const Item &rhs) { return lhs.value_ / 10000 < rhs.value_ / 10000; });
+
+    ASSERT_EQ(1000, l.size());
+    EXPECT_TRUE(std::is_sorted(l.begin(), l.end()));
+    EXPECT_EQ(&l.back(), &*l.crbegin());
+
+    ItemList other;
+
+    for (Item &item : more)
+        other.push_back(item);
+
+    l.merge(other);
+
+    EXPECT_TRUE(other.empty());
+    EXPECT_EQ(1003, l.size());
+    EXPECT_TRUE(std::is_sorted(l.begin(), l.end()));
+    EXPECT_EQ(&more.front(), &l.front());
+    EXPECT_EQ(&more.back(), &l.back());
+}
+
+TEST(IntrusiveListTests, ThrowingComparatorKeepsAllElements)
+{
+    std::vector<Item> items(100);
+    ItemList l;
+
+    for (size_t i = 0; i < items.size(); ++i)
+    {
+        items[i].value_ = static_cast<int>((i * 37) % 100);
+        l.push_back(items[i]);
+    }
+
+    int calls = 0;
+
+    auto throwing_compare = [&calls](const Item &lhs, const Item &rhs)
+    {
+        if (++calls == 200)
+            throw std::runtime_error("comparison failed");
+
+        return lhs < rhs;
+    };
+
+    EXPECT_THROW(l.sort(throwing_compare), std::runtime_error);
+
+    std::vector<int> values = values_of(l);
+    std::sort(values.begin(), values.end());
+
+    ASSERT_EQ(100, l.size());
+    for (int i = 0; i < 100; ++i)
+        EXPECT_EQ(i, values[i]);
+}
+
+TEST(IntrusiveListTests, ReverseSwapAndDestructionUnlinkCorrectly)
+{
+    std::vector<Item> items{1, 2, 3, 4};
+
+    {
+        ItemList l;
+        ItemList other;
+
+        for (Item &item : items)
+            l.push_back(item);
+
+        l.reverse();
+
+        EXPECT_EQ((std::vector<int>{4, 3, 2, 1}), values_of(l));
+
+        l.swap(other);
+
+        EXPECT_TRUE(l.empty());
+        EXPECT_EQ((std::vector<int>{4, 3, 2, 1}), values_of(other));
+
+        ItemList moved(std::move(other));
+
+        EXPECT_TRUE(other.empty());
+        EXPECT_EQ(4, moved.size());
+        EXPECT_EQ(4, moved.front().value_);
+    }
+
+    for (const Item &item : items)
+        EXPECT_FALSE(item.hook_.is_linked());
+}
@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+
+#include "list/pool_allocator.h"
+#include "persistent/list_serialization.h"
+#include <cstring>
+#include <filesystem>
+#include <numeric>
+#include <string>
+
+#include <unistd.h>
+
+TEST(ListSerializationTests, TrivialValuesRoundTripInSeveralChunks)
+{
+    List<int64_t> l;
+
+    for (int64_t i = 0; i < 1000; ++i)
+        l.push_back(i * i - 500);
+
+    MemorySink sink;
+    serialize(l, sink, 100);
+
+    MemorySource source(sink.buffer());
+    List<int64_t> restored = deserialize<int64_t>(source);
+
+    ASSERT_EQ(l.size(), restored.size());
+    EXPECT_TRUE(std::equal(l.begin(), l.end(), restored.begin()));
+
+    MemorySink empty_sink;
+    serialize(List<int64_t>(), empty_sink);
+
+    MemorySource empty_source(empty_sink.buffer());
+    EXPECT_TRUE(deserialize<int64_t>(empty_source).empty());
+}
+
+TEST(ListSerializationTests, EncodedValuesAreStreamedThroughFileChunkByChunk)
+{
+    const std::string path =
+        (std::filesystem::temp_directory_path() / ("list_serialization_" + std::to_string(::getpid()))).string();
+
+    List<std::string> l;
+
+    for (int i = 0; i < 300; ++i)
+        l.push_back(std::string(i % 17, 'a' + i % 26) + std::to_string(i));
+
+    {
+        FileSink sink(path);
+        serialize(l, sink, 256);
+    }
+
+    FileSource source(path);
+    ListReader<std::string, FileSource> reader(source);
+    List<std::string> chunk;
+    auto expected = l.begin();
+    size_t chunks = 0;
+
+    while (reader.read_chunk(chunk))
+    {
+        ++chunks;
+
+        for (const std::string &value : chunk)
+            EXPECT_EQ(*expected++, value);
+
+        chunk.clear();
+    }
+
+    EXPECT_TRUE(expected == l.end());
+    EXPECT_GT(chunks, 1);
+    EXPECT_FALSE(reader.read_chunk(chunk));
+
+    std::filesystem::remove(path);
+}
+
+TEST(ListSerializationTests, DeserializesIntoListWithPoolAllocator)
+{
+    List<std::string> l;
+
+    for (int i = 0; i < 500; ++i)
+        l.push_back(std::to_string(i));
+
+    MemorySink sink;
+    serialize(l, sink, 128);
+
+    MemorySource source(sink.buffer());
+    auto restored = deserialize<std::string, PoolAllocator<std::string, 16>>(source);
+
+    restored.push_back("end");
+    l.push_back("end");
+
+    ASSERT_EQ(l.size(), restored.size());
+    EXPECT_TRUE(std::equal(l.begin(), l.end(), restored.begin()));
+
+    MemorySink raw_sink;
+    serialize(List<int>{1, 2, 3, 4, 5, 6, 7, 8, 9}, raw_sink, 8);
+
+    MemorySource raw_source(raw_sink.buffer());
+    auto raw_restored = deserialize<int, PoolAllocator<int, 4>>(raw_source);
+
+    EXPECT_EQ(45, std::accumulate(raw_restored.begin(), raw_restored.end(), 0));
+}
+
+TEST(ListSerializationTests, MismatchedOrTruncatedStreamsThrow)
+{
+    MemorySink sink;
+    serialize(List<int32_t>{1, 2, 3, 4}, sink);
+
+    MemorySource wrong_type(sink.buffer());
+    EXPECT_THROW(deserialize<int64_t>(wrong_type), std::runtime_error);
+
+    MemorySource truncated(sink.buffer().data(), sink.buffer().size() - 1);
+    EXPECT_THROW(deserialize<int32_t>(truncated), std::runtime_error);
+
+    std::vector<unsigned char> garbage(64, 0xAB);
+    MemorySource not_a_list(garbage);
+    EXPECT_THROW(deserialize<int32_t>(not_a_list), std::runtime_error);
+
+    // Chunk counts far beyond the bytes that follow. The raw one is read in
+    // pieces, the ones read before the failure are dropped again.
+    List<int32_t> many;
+    many.assign(20000, 1);
+
+    MemorySink raw_sink;
+    serialize(many, raw_sink, 1 << 20);
+
+    std::vector<unsigned char> huge_raw_chunk = raw_sink.buffer();
+    uint32_t raw_header[2] = {(1u << 30) - 1, ((1u << 30) - 1) * 4};
+
+    std::memcpy(huge_raw_chunk.data() + sizeof(list_serialization::Header), raw_header, sizeof(raw_header));
+
+    MemorySource huge_raw(huge_raw_chunk);
+    ListReader<int32_t, MemorySource> huge_raw_reader(huge_raw);
+    List<int32_t> partial{7};
+
+    EXPECT_THROW(huge_raw_reader.read_chunk(partial), std::runtime_error);
+    EXPECT_EQ(1, partial.size());
+
+    MemorySink encoded_sink;
+    serialize(List<std::string>{"a", "b"}, encoded_sink);
+
+    std::vector<unsigned char> huge_encoded_chunk = encoded_sink.buffer();
+    uint32_t encoded_header[2] = {UINT32_MAX, 18};
+
+    std::memcpy(huge_encoded_chunk.data() + sizeof(list_serialization::Header), encoded_header, sizeof(encoded_header));
+
+    MemorySource huge_count(huge_encoded_chunk);
+    EXPECT_THROW(deserialize<std::string>(huge_count), std::runtime_error);
+
+    encoded_header[0] = 2;
+    encoded_header[1] = UINT32_MAX;
+    std::memcpy(huge_encoded_chunk.data() + sizeof(list_serialization::Header), encoded_header, sizeof(encoded_header));
+
+    MemorySource huge_bytes(huge_encoded_chunk);
+    EXPECT_THROW(deserialize<std::string>(huge_bytes), std::runtime_error);
+}
@@ -1,8 +1,17 @@
 #include <gtest/gtest.h>
 
 #include "../src/lifetime_helper/lifetime_helper.h"
+#include "list/counting_allocator.h"
 #include "list/list.h"
+#include "list/pool_allocator.h"
+#include "list/prefetch.h"
+#include <atomic>
+#include <cmath>
 #include <list>
+#include <memory_resource>
+#include <numeric>
+#include <random>
+#include <set>
 
 TEST(ListTests, SizeIsChangingCorrectly)
 {
@@ -218,3 +227,896 @@ TEST(ListTests, MergeWorksCorrectly)
     ASSERT_EQ(expected_size, destination.size());
     EXPECT_TRUE(std::is_sorted(destination.begin(), destination.end()));
 }
+
+TEST(ListTests, WorksWithPoolAllocator)
+{
+    List<int, PoolAllocator<int, 4>> l;
+
+    for (int i = 0; i < 10; ++i)
+        l.push_back(i);
+
+    ASSERT_EQ(10, l.size());
+
+    for (int i = 0; i < 5; ++i)
+        l.pop_front();
+
+    for (int i = 10; i < 15; ++i)
+        l.push_back(i);
+
+    ASSERT_EQ(10, l.size());
+
+    int expected = 5;
+    for (int value : l)
+        EXPECT_EQ(expected++, value);
+
+    List copy(l);
+    List moved(std::move(l));
+
+    ASSERT_TRUE(l.empty());
+    EXPECT_TRUE(std::equal(copy.begin(), copy.end(), moved.begin()));
+    EXPECT_FALSE(copy.get_allocator() == moved.get_allocator());
+}
+
+TEST(ListTests, PoolAllocatorRecyclesFreedNodes)
+{
+    PoolAllocator<long, 8> allocator;
+
+    long *first = allocator.allocate(1);
+    long *second = allocator.allocate(1);
+
+    allocator.deallocate(first, 1);
+    EXPECT_EQ(first, allocator.allocate(1));
+
+    allocator.deallocate(first, 1);
+    allocator.deallocate(second, 1);
+    EXPECT_EQ(second, allocator.allocate(1));
+    EXPECT_EQ(first, allocator.allocate(1));
+
+    allocator.deallocate(first, 1);
+    allocator.deallocate(second, 1);
+}
+
+TEST(ListTests, PoolAllocatorListsShareNodesThroughSplice)
+{
+    PoolAllocator<int, 4> allocator;
+    List<int, PoolAllocator<int, 4>> destination(allocator);
+
+    EXPECT_TRUE(destination.get_allocator() == allocator);
+
+    {
+        List<int, PoolAllocator<int, 4>> source(destination.get_allocator());
+
+        for (int i = 1; i <= 5; ++i)
+            source.push_back(i);
+
+        destination.splice(destination.cend(), source);
+        destination.push_back(6);
+    }
+
+    std::vector<int> expected{1, 2, 3, 4, 5, 6};
+    EXPECT_TRUE(std::equal(destination.begin(), destination.end(), expected.begin(), expected.end()));
+}
+
+TEST(ListTests, MoveAssignmentKeepsNonPropagatingAllocator)
+{
+    using PmrList = List<std::string, std::pmr::polymorphic_allocator<std::string>>;
+
+    std::pmr::unsynchronized_pool_resource first;
+    std::pmr::unsynchronized_pool_resource second;
+
+    PmrList source(&first);
+    PmrList same(&first);
+    PmrList other(&second);
+
+    for (int i = 0; i < 5; ++i)
+        source.push_back(std::string(32, static_cast<char>('a' + i)));
+
+    other.push_back("stale");
+
+    other = std::move(source);
+
+    EXPECT_EQ(&second, other.get_allocator().resource());
+    EXPECT_TRUE(source.empty());
+    ASSERT_EQ(5, other.size());
+
+    int i = 0;
+    for (const std::string &value : other)
+        EXPECT_EQ(std::string(32, static_cast<char>('a' + i++)), value);
+
+    source.push_back("again");
+    const std::string *node_value = &source.front();
+
+    same = std::move(source);
+
+    EXPECT_EQ(&first, same.get_allocator().resource());
+    EXPECT_TRUE(source.empty());
+    EXPECT_EQ(node_value, &same.front());
+}
+
+TEST(ListTests, PoolAllocatedObjectsAreDestructedCorrectly)
+{
+    {
+        List<LifetimeHelper, PoolAllocator<LifetimeHelper, 3>> l;
+
+        l.resize(10);
+        EXPECT_EQ(10, LifetimeHelper::get_alive_count());
+
+        l.resize(2);
+        EXPECT_EQ(2, LifetimeHelper::get_alive_count());
+
+        l.resize(7);
+        EXPECT_EQ(7, LifetimeHelper::get_alive_count());
+    }
+
+    EXPECT_EQ(0, LifetimeHelper::get_alive_count());
+}
+
+TEST(ListTests, RangeConstructionAndCopyKeepListConsistent)
+{
+    std::vector<int> vec{5, 4, 3, 2, 1};
+    List<int> l(vec.begin(), vec.end());
+
+    ASSERT_EQ(vec.size(), l.size());
+    EXPECT_TRUE(std::equal(vec.crbegin(), vec.crend(), l.crbegin()));
+
+    List<int> copy(l);
+
+    ASSERT_EQ(l.size(), copy.size());
+    EXPECT_TRUE(std::equal(vec.crbegin(), vec.crend(), copy.crbegin()));
+
+    copy.push_front(6);
+    copy.push_back(0);
+
+    EXPECT_EQ(6, copy.front());
+    EXPECT_EQ(0, copy.back());
+    EXPECT_EQ(vec.size() + 2, copy.size());
+
+    copy.clear();
+    copy.assign({1, 2});
+
+    EXPECT_EQ(2, copy.size());
+    EXPECT_EQ(1, copy.front());
+    EXPECT_EQ(2, copy.back());
+}
+
+TEST(ListTests, BulkCopyAndClearDestructObjectsCorrectly)
+{
+    {
+        List<LifetimeHelper> l;
+        l.resize(20);
+
+        List<LifetimeHelper> copy(l);
+        EXPECT_EQ(40, LifetimeHelper::get_alive_count());
+
+        copy.resize(5);
+        EXPECT_EQ(25, LifetimeHelper::get_alive_count());
+
+        l.clear();
+        EXPECT_EQ(5, LifetimeHelper::get_alive_count());
+        EXPECT_TRUE(l.empty());
+    }
+
+    EXPECT_EQ(0, LifetimeHelper::get_alive_count());
+}
+
+TEST(ListTests, SpliceKeepsSizesInSync)
+{
+    List<int> source{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    List<int> destination{10, 11};
+
+    auto first = std::next(source.cbegin(), 2);
+    auto last = std::next(first, 3);
+
+    destination.splice(destination.cend(), source, first, last, 3);
+
+    EXPECT_EQ(7, source.size());
+    EXPECT_EQ(5, destination.size());
+    EXPECT_EQ(4, destination.back());
+
+    destination.splice(destination.cbegin(), source);
+
+    EXPECT_TRUE(source.empty());
+    EXPECT_EQ(12, destination.size());
+    EXPECT_EQ(0, destination.front());
+    EXPECT_EQ(4, destination.back());
+
+    destination.splice(destination.cbegin(), destination, destination.cbegin());
+    destination.splice(std::next(destination.cbegin()), destination, destination.cbegin());
+
+    EXPECT_EQ(12, destination.size());
+    EXPECT_EQ(0, destination.front());
+
+    destination.splice(destination.cbegin(), destination, --destination.cend());
+
+    EXPECT_EQ(12, destination.size());
+    EXPECT_EQ(4, destination.front());
+    EXPECT_EQ(3, destination.back());
+}
+
+TEST(ListTests, SortHandlesPresortedRuns)
+{
+    std::vector<int> values;
+
+    for (int i = 0; i < 500; ++i)
+        values.push_back(i);
+
+    for (int i = 1000; i > 500; --i)
+        values.push_back(i);
+
+    for (int i = 0; i < 300; ++i)
+        values.push_back((i * 7919) % 1301);
+
+    List<int> l(values.begin(), values.end());
+    std::sort(values.begin(), values.end());
+
+    l.sort();
+
+    ASSERT_EQ(values.size(), l.size());
+    EXPECT_TRUE(std::equal(values.cbegin(), values.cend(), l.cbegin()));
+    EXPECT_TRUE(std::equal(values.crbegin(), values.crend(), l.crbegin()));
+
+    l.sort(std::greater<int>());
+
+    EXPECT_TRUE(std::equal(values.crbegin(), values.crend(), l.cbegin()));
+    EXPECT_EQ(values.front(), l.back());
+}
+
+TEST(ListTests, SortIsStable)
+{
+    List<std::pair<int, int>> l;
+
+    for (int i = 0; i < 200; ++i)
+        l.emplace_back(std::pair{(i * 37) % 10, i});
+
+    l.sort([](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; });
+
+    EXPECT_TRUE(std::is_sorted(l.cbegin(), l.cend()));
+}
+
+TEST(ListTests, ThrowingComparatorKeepsAllElements)
+{
+    List<int> l;
+
+    for (int i = 0; i < 100; ++i)
+        l.push_back((i * 31) % 17);
+
+    int calls = 0;
+    auto compare = [&calls](int lhs, int rhs)
+    {
+        if (++calls == 150)
+            throw std::runtime_error("compare failed");
+
+        return lhs < rhs;
+    };
+
+    EXPECT_THROW(l.sort(compare), std::runtime_error);
+
+    ASSERT_EQ(100, l.size());
+    EXPECT_EQ(100, std::distance(l.begin(), l.end()));
+    EXPECT_EQ(100, std::distance(l.rbegin(), l.rend()));
+
+    l.sort();
+    EXPECT_TRUE(std::is_sorted(l.cbegin(), l.cend()));
+}
+
+TEST(ListTests, ParallelSortWorksCorrectly)
+{
+    std::mt19937 generator(42);
+    std::vector<std::pair<int, int>> values;
+
+    for (int i = 0; i < 100000; ++i)
+        values.emplace_back(static_cast<int>(generator() % 1000), i);
+
+    auto by_key = [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; };
+
+    for (size_t threads : {1, 2, 3, 4})
+    {
+        List<std::pair<int, int>> l(values.begin(), values.end());
+
+        l.parallel_sort(by_key, threads);
+
+        ASSERT_EQ(values.size(), l.size());
+        EXPECT_TRUE(std::is_sorted(l.cbegin(), l.cend()));
+        EXPECT_EQ(values.size(), std::distance(l.crbegin(), l.crend()));
+    }
+}
+
+TEST(ListTests, ThrowingComparatorKeepsAllElementsInParallelSort)
+{
+    List<int> source;
+
+    for (int i = 0; i < 100000; ++i)
+        source.push_back((i * 7919) % 10007);
+
+    std::atomic<int> total_calls = 0;
+    List<int> counted(source);
+
+    counted.parallel_sort([&total_calls](int lhs, int rhs) { return ++total_calls, lhs < rhs; }, 4);
+
+    // The first limit trips while segments are sorted, the second one while
+    // they are merged.
+    for (int limit : {1000, total_calls - 20000})
+    {
+        std::atomic<int> calls = 0;
+        auto compare = [&calls, limit](int lhs, int rhs)
+        {
+            if (++calls == limit)
+                throw std::runtime_error("compare failed");
+
+            return lhs < rhs;
+        };
+
+        List<int> l(source);
+
+        EXPECT_THROW(l.parallel_sort(compare, 4), std::runtime_error);
+
+        ASSERT_EQ(100000, l.size());
+        EXPECT_EQ(100000, std::distance(l.begin(), l.end()));
+        EXPECT_EQ(100000, std::distance(l.rbegin(), l.rend()));
+
+        l.parallel_sort(4);
+        EXPECT_TRUE(std::equal(l.cbegin(), l.cend(), counted.cbegin()));
+    }
+}
+
+TEST(ListTests, SortByKeyOrdersByProjectedKeys)
+{
+    struct Record
+    {
+        double score;
+        int id;
+        std::string name;
+    };
+
+    std::vector<Record> records;
+
+    for (int i = 0; i < 300; ++i)
+        records.push_back(Record{((i * 37) % 101 - 50) * 0.5, i, std::to_string((i * 13) % 29)});
+
+    List<Record> l(records.begin(), records.end());
+
+    l.sort_by_key(&Record::score);
+
+    ASSERT_EQ(records.size(), l.size());
+    EXPECT_TRUE(std::is_sorted(l.cbegin(), l.cend(),
+                               [](const Record &lhs, const Record &rhs) { return lhs.score < rhs.score; }));
+
+    std::stable_sort(records.begin(), records.end(),
+                     [](const Record &lhs, const Record &rhs) { return lhs.score < rhs.score; });
+
+    EXPECT_TRUE(std::equal(records.cbegin(), records.cend(), l.cbegin(),
+                           [](const Record &lhs, const Record &rhs) { return lhs.id == rhs.id; }));
+
+    l.sort_by_key([](const Record &record) { return record.id; }, std::greater<int>());
+
+    EXPECT_EQ(299, l.front().id);
+    EXPECT_EQ(0, l.back().id);
+    EXPECT_TRUE(std::is_sorted(l.crbegin(), l.crend(),
+                               [](const Record &lhs, const Record &rhs) { return lhs.id < rhs.id; }));
+
+    l.sort_by_key(&Record::name);
+
+    EXPECT_TRUE(std::is_sorted(l.cbegin(), l.cend(),
+                               [](const Record &lhs, const Record &rhs) { return lhs.name < rhs.name; }));
+    EXPECT_EQ(records.size(), std::distance(l.crbegin(), l.crend()));
+}
+
+TEST(ListTests, SortByKeyProjectsEveryElementOnce)
+{
+    List<int> l;
+
+    for (int i = 0; i < 1000; ++i)
+        l.push_back((i * 7919) % 1009 - 500);
+
+    int projections = 0;
+
+    l.sort_by_key([&projections](int value) { return ++projections, static_cast<long long>(value); });
+
+    EXPECT_EQ(1000, projections);
+    EXPECT_TRUE(std::is_sorted(l.cbegin(), l.cend()));
+}
+
+TEST(ListTests, ArithmeticSortTakesRadixPath)
+{
+    std::mt19937_64 generator(7);
+    std::vector<double> values;
+
+    for (int i = 0; i < 5000; ++i)
+        values.push_back(static_cast<double>(static_cast<int64_t>(generator() % 20001) - 10000) / 7);
+
+    List<double> l(values.begin(), values.end());
+    List<uint64_t> ids;
+
+    for (int i = 0; i < 5000; ++i)
+        ids.push_back(generator());
+
+    l.sort();
+    ids.sort(std::greater<uint64_t>());
+    std::sort(values.begin(), values.end());
+
+    EXPECT_TRUE(std::equal(values.cbegin(), values.cend(), l.cbegin()));
+    EXPECT_TRUE(std::equal(values.crbegin(), values.crend(), l.crbegin()));
+    EXPECT_TRUE(std::is_sorted(ids.crbegin(), ids.crend()));
+    EXPECT_EQ(5000, std::distance(ids.cbegin(), ids.cend()));
+}
+
+TEST(ListTests, RadixSortKeepsOrderOfSignedZeros)
+{
+    std::vector<double> values;
+
+    for (int i = 0; i < 300; ++i)
+        values.push_back(i % 3 == 0 ? -0.0 : (i % 3 == 1 ? 0.0 : (i % 7) - 3.0));
+
+    List<double> radix(values.begin(), values.end());
+    List<double> merge(values.begin(), values.end());
+
+    radix.sort();
+    merge.sort([](double lhs, double rhs) { return lhs < rhs; });
+
+    ASSERT_TRUE(std::equal(merge.cbegin(), merge.cend(), radix.cbegin(), radix.cend()));
+    EXPECT_TRUE(std::equal(merge.cbegin(), merge.cend(), radix.cbegin(), radix.cend(),
+                           [](double lhs, double rhs) { return std::signbit(lhs) == std::signbit(rhs); }));
+}
+
+TEST(ListTests, CopyAllocatesExactlyOneNodePerElement)
+{
+    using CountingList = List<int, CountingAllocator<int>>;
+
+    CountingList source{432, 66, 123, 778, 1, 745, 7, 1, 6543, 78};
+    const std::shared_ptr<AllocationStats> stats = source.get_allocator().stats();
+
+    ASSERT_EQ(10, stats->allocations);
+    const size_t node_bytes = stats->bytes_allocated / 10;
+
+    {
+        CountingList copy(source);
+
+        EXPECT_EQ(20, stats->allocations);
+        EXPECT_EQ(20 * node_bytes, stats->bytes_allocated);
+        EXPECT_EQ(0, stats->deallocations);
+
+        copy.sort();
+        copy.reverse();
+        source.splice(source.cend(), copy);
+
+        EXPECT_EQ(20, stats->allocations);
+    }
+
+    EXPECT_EQ(20, stats->live_allocations());
+
+    source.clear();
+
+    EXPECT_EQ(0, stats->live_allocations());
+    EXPECT_EQ(0, stats->live_bytes());
+}
+
+TEST(ListTests, RelinkingAlgorithmsNeverTouchElements)
+{
+    std::mt19937 generator(7);
+    List<LifetimeHelper> l;
+    List<LifetimeHelper> other;
+
+    for (int i = 0; i < 300; ++i)
+    {
+        l.emplace_back(static_cast<int>(generator() % 1000));
+        other.emplace_back(static_cast<int>(generator() % 1000));
+    }
+
+    auto by_number = [](const LifetimeHelper &lhs, const LifetimeHelper &rhs)
+    { return lhs.get_object_number() < rhs.get_object_number(); };
+
+    LifetimeHelper::Scope scope;
+
+    l.sort(by_number);
+    other.sort(by_number);
+    l.merge(other, by_number);
+    l.reverse();
+    other.splice(other.cend(), l, l.cbegin(), std::next(l.cbegin(), 100));
+
+    EXPECT_EQ(LifetimeCounters(), scope.diff());
+    EXPECT_EQ(500, l.size());
+    EXPECT_EQ(100, other.size());
+}
+
+TEST(ListTests, InterleavedTraversalMatchesSequentialOne)
+{
+    List<int> l;
+
+    for (int i = 0; i < 1000; ++i)
+        l.push_back(i % 7 == 3 && i > 500 ? -i : i);
+
+    for (size_t lanes : {1, 3, 16, 2000})
+    {
+        auto bounds = split_into_lanes(l, lanes);
+
+        EXPECT_EQ(l.begin(), bounds.front());
+        EXPECT_EQ(l.end(), bounds.back());
+
+        std::vector<int> visited;
+        for_each_interleaved(bounds, [&visited](int value) { visited.push_back(value); });
+        std::sort(visited.begin(), visited.end());
+
+        std::vector<int> expected(l.begin(), l.end());
+        std::sort(expected.begin(), expected.end());
+
+        EXPECT_EQ(expected, visited);
+        EXPECT_EQ(std::accumulate(l.begin(), l.end(), 0), accumulate_interleaved(bounds, 0));
+
+        auto count_negative = [](size_t count, int value) { return count + (value < 0 ? 1 : 0); };
+
+        EXPECT_EQ(std::accumulate(l.begin(), l.end(), size_t(0), count_negative),
+                  accumulate_interleaved(bounds, size_t(0), count_negative, std::plus<>()));
+
+        auto found = find_if_interleaved(bounds, [](int value) { return value < 0; });
+
+        ASSERT_NE(l.end(), found);
+        EXPECT_EQ(-507, *found);
+        EXPECT_EQ(l.end(), find_if_interleaved(bounds, [](int value) { return value > 1000; }));
+    }
+}
+
+TEST(ListTests, RangeInsertAndEraseMatchStdList)
+{
+    std::vector<int> values{7, 8, 9};
+    List<int> l{1, 2, 3};
+    std::list<int> reference{1, 2, 3};
+
+    auto inserted = l.insert(std::next(l.cbegin()), values.begin(), values.end());
+    reference.insert(std::next(reference.cbegin()), values.begin(), values.end());
+    EXPECT_EQ(7, *inserted);
+
+    inserted = l.insert(l.cend(), 3, 0);
+    reference.insert(reference.cend(), 3, 0);
+    EXPECT_EQ(0, *inserted);
+
+    inserted = l.insert(l.cbegin(), {-2, -1});
+    reference.insert(reference.cbegin(), {-2, -1});
+    EXPECT_EQ(-2, *inserted);
+
+    EXPECT_TRUE(l.insert(l.cend(), values.end(), values.end()) == l.end());
+
+    auto next = l.erase(std::next(l.cbegin(), 2), std::next(l.cbegin(), 6));
+    auto ref_next = reference.erase(std::next(reference.cbegin(), 2), std::next(reference.cbegin(), 6));
+    EXPECT_EQ(*ref_next, *next);
+
+    ASSERT_EQ(reference.size(), l.size());
+    EXPECT_TRUE(std::equal(reference.begin(), reference.end(), l.begin()));
+    EXPECT_TRUE(std::equal(reference.rbegin(), reference.rend(), l.rbegin()));
+
+    EXPECT_TRUE(l.erase(l.cbegin(), l.cend()) == l.end());
+    EXPECT_TRUE(l.empty());
+}
+
+TEST(ListTests, RemoveIfAndUniqueFreeNodesInOnePass)
+{
+    {
+        List<LifetimeHelper> l;
+        l.resize(10);
+
+        int index = 0;
+        EXPECT_EQ(5, l.remove_if([&index](const LifetimeHelper &) { return index++ % 2 == 0; }));
+        EXPECT_EQ(5, l.size());
+        EXPECT_EQ(5, LifetimeHelper::get_alive_count());
+    }
+
+    EXPECT_EQ(0, LifetimeHelper::get_alive_count());
+
+    List<int> l{1, 1, 2, 3, 3, 3, 1, 4, 4, 5, 1};
+
+    EXPECT_EQ(4, l.unique());
+    EXPECT_EQ(7, l.size());
+    EXPECT_TRUE(std::equal(l.begin(), l.end(), std::vector<int>{1, 2, 3, 1, 4, 5, 1}.begin()));
+
+    EXPECT_EQ(3, l.remove(l.front()));
+    EXPECT_EQ(4, l.size());
+    EXPECT_TRUE(std::equal(l.rbegin(), l.rend(), std::vector<int>{5, 4, 3, 2}.begin()));
+}
+
+TEST(ListTests, ParallelTraversalVisitsEveryElementOnce)
+{
+    List<int64_t> l;
+
+    for (int64_t i = 0; i < 100000; ++i)
+        l.push_back(i);
+
+    l.parallel_for_each([](int64_t &value) { value *= 2; }, 4);
+
+    EXPECT_EQ(int64_t(99999) * 100000, l.parallel_reduce(int64_t(0), std::plus<>(), 4));
+    EXPECT_EQ(std::accumulate(l.begin(), l.end(), int64_t(0)), l.parallel_reduce(int64_t(0), std::plus<>(), 1));
+
+    List<std::string> digits;
+
+    for (int i = 0; i < 30000; ++i)
+        digits.push_back(std::to_string(i % 10));
+
+    std::string expected = std::accumulate(digits.begin(), digits.end(), std::string(">"));
+    EXPECT_EQ(expected, digits.parallel_reduce(std::string(">"), std::plus<>(), 3));
+
+    auto add_length = [](size_t count, const std::string &digit) { return count + digit.size(); };
+
+    EXPECT_EQ(digits.size(), digits.parallel_reduce(size_t(0), add_length, std::plus<>(), 3));
+    EXPECT_EQ(0, List<std::string>().parallel_reduce(size_t(0), add_length, std::plus<>(), 3));
+
+    EXPECT_THROW(l.parallel_for_each(
+                     [](int64_t &value)
+                     {
+                         if (value == 1000)
+                             throw std::runtime_error("failed");
+                     },
+                     4),
+                 std::runtime_error);
+    EXPECT_EQ(100000, l.size());
+}
+
+TEST(ListTests, NodeHandlesMoveElementsWithoutAllocating)
+{
+    using CountingList = List<int, CountingAllocator<int>>;
+
+    CountingList pending{1, 2, 3, 4, 5};
+    CountingList done(pending.get_allocator());
+    const std::shared_ptr<AllocationStats> stats = pending.get_allocator().stats();
+
+    ASSERT_EQ(5, stats->allocations);
+
+    for (int round = 0; round < 3; ++round)
+    {
+        while (!pending.empty())
+        {
+            CountingList::node_type handle = pending.extract(pending.cbegin());
+
+            ASSERT_FALSE(handle.empty());
+            handle.value() *= 10;
+            done.push_back(std::move(handle));
+            EXPECT_TRUE(handle.empty());
+        }
+
+        pending.swap(done);
+    }
+
+    EXPECT_EQ(5, stats->allocations);
+    EXPECT_EQ(0, stats->deallocations);
+    EXPECT_TRUE(std::equal(pending.begin(), pending.end(), std::vector<int>{1000, 2000, 3000, 4000, 5000}.begin()));
+
+    auto inserted = pending.insert(std::next(pending.cbegin()), pending.extract(std::prev(pending.cend())));
+    EXPECT_EQ(5000, *inserted);
+    EXPECT_EQ(5, pending.size());
+    EXPECT_TRUE(std::equal(pending.rbegin(), pending.rend(), std::vector<int>{4000, 3000, 2000, 5000, 1000}.begin()));
+
+    {
+        CountingList::node_type dropped = pending.extract(pending.cbegin());
+        EXPECT_EQ(4, pending.size());
+    }
+
+    EXPECT_EQ(1, stats->deallocations);
+    EXPECT_TRUE(pending.insert(pending.cbegin(), CountingList::node_type()) == pending.begin());
+    EXPECT_EQ(5000, pending.front());
+}
+
+TEST(ListTests, AssignmentReusesExistingNodes)
+{
+    using CountingList = List<int, CountingAllocator<int>>;
+
+    CountingList l{1, 2, 3, 4, 5, 6};
+    const std::shared_ptr<AllocationStats> stats = l.get_allocator().stats();
+
+    l.assign({10, 20, 30, 40, 50, 60});
+    EXPECT_EQ(6, stats->allocations);
+    EXPECT_EQ(0, stats->deallocations);
+
+    l.assign({7, 8});
+    EXPECT_EQ(6, stats->allocations);
+    EXPECT_EQ(4, stats->deallocations);
+    EXPECT_TRUE(std::equal(l.rbegin(), l.rend(), std::vector<int>{8, 7}.begin()));
+
+    l.assign(5, 9);
+    EXPECT_EQ(9, stats->allocations);
+    EXPECT_EQ(5, l.size());
+    EXPECT_EQ(5, std::count(l.begin(), l.end(), 9));
+
+    CountingList other(l.get_allocator());
+    other.assign({1, 2, 3, 4, 5, 6, 7});
+    ASSERT_EQ(16, stats->allocations);
+
+    other = l;
+    EXPECT_EQ(16, stats->allocations);
+    EXPECT_EQ(6, stats->deallocations);
+    ASSERT_EQ(l.size(), other.size());
+    EXPECT_TRUE(std::equal(l.rbegin(), l.rend(), other.rbegin()));
+
+    l.clear();
+    other = l;
+    EXPECT_TRUE(other.empty());
+    EXPECT_EQ(16, stats->deallocations);
+}
+
+TEST(ListTests, CopyAssignmentDestructsOnlyTheShortfall)
+{
+    {
+        List<LifetimeHelper> source;
+        List<LifetimeHelper> destination;
+
+        source.resize(4);
+        destination.resize(10);
+
+        EXPECT_EQ(14, LifetimeHelper::get_alive_count());
+
+        destination = source;
+        EXPECT_EQ(8, LifetimeHelper::get_alive_count());
+
+        source.resize(12);
+        destination = source;
+        EXPECT_EQ(24, LifetimeHelper::get_alive_count());
+    }
+
+    EXPECT_EQ(0, LifetimeHelper::get_alive_count());
+}
+
+TEST(ListTests, PositionalAccessFollowsStructuralChanges)
+{
+    List<int> l;
+    std::vector<int> reference;
+
+    auto check_positions = [&l, &reference]
+    {
+        ASSERT_EQ(reference.size(), l.size());
+
+        for (size_t i = 0; i < reference.size(); i += 7)
+        {
+            ASSERT_EQ(reference[i], *l.nth(i));
+            ASSERT_EQ(i, l.index_of(l.nth(i)));
+        }
+
+        EXPECT_TRUE(l.nth(l.size()) == l.end());
+        EXPECT_EQ(l.size(), l.index_of(l.cend()));
+    };
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        l.push_back(i);
+        reference.push_back(i);
+    }
+
+    check_positions();
+
+    for (int i = 0; i < 300; ++i)
+    {
+        l.push_front(-i);
+        reference.insert(reference.begin(), -i);
+        l.push_back(10000 + i);
+        reference.push_back(10000 + i);
+    }
+
+    check_positions();
+
+    for (int i = 0; i < 200; ++i)
+    {
+        l.pop_front();
+        reference.erase(reference.begin());
+        l.pop_back();
+        reference.pop_back();
+    }
+
+    check_positions();
+
+    l.erase(l.nth(1000), l.nth(1500));
+    reference.erase(reference.begin() + 1000, reference.begin() + 1500);
+    l.insert(l.nth(2000), 3, 42);
+    reference.insert(reference.begin() + 2000, 3, 42);
+
+    check_positions();
+
+    l.reverse();
+    std::reverse(reference.begin(), reference.end());
+
+    check_positions();
+
+    EXPECT_EQ(reference[3000], *l.advance(l.nth(100), 2900));
+    EXPECT_EQ(reference[100], *l.advance(l.nth(3000), -2900));
+    EXPECT_EQ(reference[12], *l.advance(l.nth(10), 2));
+
+    List<int> moved(std::move(l));
+
+    EXPECT_EQ(reference[4321], *moved.nth(4321));
+    EXPECT_EQ(4321, moved.index_of(moved.nth(4321)));
+}
+
+TEST(ListTests, SkipIndexSurvivesRandomSingleElementChanges)
+{
+    std::mt19937 generator(7);
+    List<int> l;
+    std::vector<int> reference;
+
+    for (int i = 0; i < 3000; ++i)
+    {
+        l.push_back(i);
+        reference.push_back(i);
+    }
+
+    ASSERT_EQ(0, *l.nth(0));
+
+    for (int step = 0; step < 4000; ++step)
+    {
+        size_t position = generator() % (reference.size() + 1);
+
+        switch (generator() % 4)
+        {
+        case 0:
+            l.insert(l.nth(position), step);
+            reference.insert(reference.begin() + position, step);
+            break;
+        case 1:
+            l.push_front(step);
+            reference.insert(reference.begin(), step);
+            break;
+        case 2:
+            if (position < reference.size())
+            {
+                l.erase(l.nth(position));
+                reference.erase(reference.begin() + position);
+            }
+            break;
+        default:
+            l.pop_back();
+            reference.pop_back();
+            break;
+        }
+
+        if (step % 50 == 0)
+        {
+            size_t probe = generator() % reference.size();
+
+            ASSERT_EQ(reference[probe], *l.nth(probe));
+            ASSERT_EQ(probe, l.index_of(l.nth(probe)));
+        }
+    }
+
+    ASSERT_EQ(reference.size(), l.size());
+    EXPECT_TRUE(std::equal(reference.begin(), reference.end(), l.begin()));
+}
+
+TEST(ListTests, SortedInsertionAndBoundsMatchStdMultiset)
+{
+    std::mt19937 generator(11);
+    List<int> l;
+    std::multiset<int> reference;
+
+    for (int i = 0; i < 2000; ++i)
+    {
+        // Nearly ordered with occasional far jumps.
+        int value = generator() % 10 == 0 ? static_cast<int>(generator() % 3000) : i + static_cast<int>(generator() % 20);
+
+        auto inserted = l.insert_sorted(value);
+        reference.insert(value);
+
+        ASSERT_EQ(value, *inserted);
+    }
+
+    ASSERT_TRUE(std::equal(reference.begin(), reference.end(), l.begin()));
+
+    auto hint = l.cbegin();
+
+    for (int value : {5, 5, 1500, -3, 4000})
+    {
+        hint = l.insert_sorted(hint, value);
+        reference.insert(value);
+    }
+
+    ASSERT_TRUE(std::equal(reference.begin(), reference.end(), l.begin()));
+
+    for (int value : {-10, -3, 0, 5, 777, 1500, 2999, 4000, 5000})
+    {
+        EXPECT_EQ(std::distance(reference.begin(), reference.lower_bound(value)),
+                  std::distance(l.begin(), l.lower_bound(value)));
+        EXPECT_EQ(std::distance(reference.begin(), reference.upper_bound(value)),
+                  std::distance(l.begin(), l.upper_bound(value)));
+
+        auto range = l.equal_range(value);
+        EXPECT_EQ(reference.count(value), std::distance(range.first, range.second));
+    }
+
+    List<int> descending{9, 7, 5, 3};
+
+    descending.insert_sorted(6, std::greater<int>());
+    EXPECT_EQ(6, *std::next(descending.begin(), 2));
+    EXPECT_EQ(3, std::distance(descending.begin(), descending.lower_bound(5, std::greater<int>())));
+}
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+
+#include "list/lru_cache.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+TEST(LruCacheTests, EvictsLeastRecentlyUsedEntries)
+{
+    LruCache<int, std::string> cache(3);
+    std::vector<int> evicted;
+    auto record = [&evicted](int &&key, std::string &&) { evicted.push_back(key); };
+
+    cache.put(1, "one", record);
+    cache.put(2, "two", record);
+    cache.put(3, "three", record);
+
+    ASSERT_NE(nullptr, cache.get(1));
+    EXPECT_EQ("one", *cache.get(1));
+    EXPECT_TRUE(cache.touch(2));
+
+    cache.put(4, "four", record);
+
+    EXPECT_EQ(std::vector<int>{3}, evicted);
+    EXPECT_EQ(3, cache.size());
+    EXPECT_FALSE(cache.contains(3));
+
+    // peek() doesn't refresh 1, so it goes next.
+    EXPECT_EQ("one", *cache.peek(1));
+    cache.put(5, "five", record);
+
+    EXPECT_EQ((std::vector<int>{3, 1}), evicted);
+
+    cache.put(2, "TWO", record);
+    EXPECT_EQ("TWO", *cache.get(2));
+    EXPECT_EQ(3, cache.size());
+
+    EXPECT_TRUE(cache.erase(4));
+    EXPECT_FALSE(cache.erase(4));
+    EXPECT_EQ(2, cache.size());
+
+    evicted.clear();
+    EXPECT_EQ(2, cache.evict(10, record));
+    EXPECT_EQ((std::vector<int>{5, 2}), evicted);
+    EXPECT_TRUE(cache.empty());
+    EXPECT_EQ(nullptr, cache.get(2));
+}
+
+TEST(LruCacheTests, WeigherBoundsTheTotalWeight)
+{
+    LruCache<std::string, std::string> cache(10, [](const std::string &, const std::string &value) { return value.size(); });
+
+    cache.put("a", std::string(4, 'a'));
+    cache.put("b", std::string(4, 'b'));
+    EXPECT_EQ(8, cache.weight());
+
+    cache.put("c", std::string(4, 'c'));
+    EXPECT_EQ(8, cache.weight());
+    EXPECT_FALSE(cache.contains("a"));
+
+    // An entry heavier than the capacity stays on its own.
+    cache.put("d", std::string(20, 'd'));
+    EXPECT_EQ(1, cache.size());
+    EXPECT_EQ(20, cache.weight());
+
+    cache.put("d", std::string(2, 'd'));
+    EXPECT_EQ(2, cache.weight());
+}
+
+TEST(LruCacheTests, ThrowingWeigherLeavesCacheUnchanged)
+{
+    LruCache<int, std::string> cache(100,
+                                     [](const int &, const std::string &value) -> size_t
+                                     {
+                                         if (value.empty())
+                                             throw std::invalid_argument("empty value");
+
+                                         return value.size();
+                                     });
+
+    cache.put(1, "one");
+    cache.put(2, "two");
+
+    EXPECT_THROW(cache.put(3, ""), std::invalid_argument);
+    EXPECT_THROW(cache.put(1, ""), std::invalid_argument);
+
+    EXPECT_EQ(2, cache.size());
+    EXPECT_EQ(6, cache.weight());
+    EXPECT_FALSE(cache.contains(3));
+    EXPECT_EQ("one", *cache.peek(1));
+
+    EXPECT_EQ(2, cache.evict(5));
+    EXPECT_TRUE(cache.empty());
+    EXPECT_EQ(0, cache.weight());
+}
+
+TEST(LruCacheTests, MatchesReferenceModelUnderChurn)
+{
+    LruCache<int, int> cache(100);
+    std::vector<std::pair<int, int>> model;
+
+    for (int step = 0; step < 20000; ++step)
+    {
+        int key = (step * 7919) % 397;
+
+        auto found = std::find_if(model.begin(), model.end(), [key](const auto &entry) { return entry.first == key; });
+
+        if (step % 3 == 0)
+        {
+            int *value = cache.get(key);
+
+            ASSERT_EQ(found != model.end(), value != nullptr);
+
+            if (value != nullptr)
+            {
+                ASSERT_EQ(found->second, *value);
+                std::rotate(model.begin(), found, found + 1);
+            }
+        }
+        else
+        {
+            cache.put(key, step);
+
+            if (found != model.end())
+                model.erase(found);
+
+            model.insert(model.begin(), {key, step});
+
+            if (model.size() > 100)
+                model.pop_back();
+        }
+
+        ASSERT_EQ(model.size(), cache.size());
+    }
+}
@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+
+#include "persistent/mapped_list.h"
+#include <cstdio>
+#include <filesystem>
+#include <list>
+#include <vector>
+
+#include <unistd.h>
+
+namespace
+{
+
+struct Point
+{
+    int32_t x;
+    int32_t y;
+};
+
+// Removes the backing file before and after every test.
+class MappedListTests : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        path_ = (std::filesystem::temp_directory_path() /
+                 ("mapped_list_" + std::to_string(::getpid()) + "_" +
+                  ::testing::UnitTest::GetInstance()->current_test_info()->name()))
+                    .string();
+
+        std::filesystem::remove(path_);
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove(path_);
+    }
+
+    std::string path_;
+};
+
+template <class ListType>
+std::vector<typename ListType::value_type> values_of(const ListType &l)
+{
+    return {l.begin(), l.end()};
+}
+
+} // namespace
+
+TEST_F(MappedListTests, ListSurvivesReopening)
+{
+    {
+        MappedList<int> l(path_);
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            l.push_back(i);
+            l.push_front(-i);
+        }
+
+        l.pop_front();
+        l.pop_back();
+        l.flush();
+    }
+
+    MappedList<int> reopened(path_);
+
+    ASSERT_EQ(1998, reopened.size());
+    EXPECT_EQ(-998, reopened.front());
+    EXPECT_EQ(998, reopened.back());
+    EXPECT_TRUE(std::is_sorted(reopened.begin(), reopened.end()));
+
+    reopened.push_back(reopened.front());
+
+    EXPECT_EQ(-998, reopened.back());
+}
+
+TEST_F(MappedListTests, InsertEraseAndSpliceMatchStdList)
+{
+    MappedList<int> l(path_);
+    std::list<int> reference;
+
+    for (int i = 0; i < 300; ++i)
+    {
+        auto it = l.insert(std::next(l.cbegin(), l.size() / 3), i);
+        auto ref_it = reference.insert(std::next(reference.cbegin(), reference.size() / 3), i);
+
+        EXPECT_EQ(*ref_it, *it);
+    }
+
+    for (int i = 0; i < 100; ++i)
+    {
+        l.erase(std::next(l.cbegin(), l.size() / 2));
+        reference.erase(std::next(reference.cbegin(), reference.size() / 2));
+    }
+
+    l.splice(l.cbegin(), l, std::next(l.cbegin(), 50), std::next(l.cbegin(), 80));
+    reference.splice(reference.cbegin(), reference, std::next(reference.cbegin(), 50),
+                     std::next(reference.cbegin(), 80));
+
+    l.splice(l.cend(), l, l.cbegin());
+    reference.splice(reference.cend(), reference, reference.cbegin());
+
+    ASSERT_EQ(reference.size(), l.size());
+    EXPECT_TRUE(std::equal(reference.begin(), reference.end(), l.begin()));
+    EXPECT_TRUE(std::equal(reference.crbegin(), reference.crend(), l.crbegin()));
+}
+
+TEST_F(MappedListTests, SortAndReverseArePersisted)
+{
+    {
+        MappedList<Point> l(path_);
+
+        for (int i = 0; i < 200; ++i)
+            l.push_back(Point{(i * 37) % 200, i});
+
+        l.sort([](const Point &lhs, const Point &rhs) { return lhs.x < rhs.x; });
+        l.reverse();
+    }
+
+    MappedList<Point> reopened(path_);
+    std::vector<Point> values = values_of(reopened);
+
+    ASSERT_EQ(200, values.size());
+
+    for (size_t i = 0; i < values.size(); ++i)
+        EXPECT_EQ(199 - static_cast<int>(i), values[i].x);
+}
+
+TEST_F(MappedListTests, OpeningWithDifferentLayoutThrows)
+{
+    {
+        MappedList<int> l(path_);
+        l.push_back(1);
+    }
+
+    EXPECT_THROW(MappedList<double> l(path_), std::runtime_error);
+    EXPECT_THROW(MappedList<Point> l(path_), std::runtime_error);
+
+    std::FILE *file = std::fopen(path_.c_str(), "r+b");
+    ASSERT_NE(nullptr, file);
+    std::fputs("garbage!", file);
+    std::fclose(file);
+
+    EXPECT_THROW(MappedList<int> l(path_), std::runtime_error);
+}
+
+TEST_F(MappedListTests, OpeningWithCorruptLinksThrows)
+{
+    {
+        MappedList<int> l(path_);
+        l.push_back(1);
+        l.push_back(2);
+    }
+
+    // head_ follows magic, version, three layout fields, capacity and size.
+    const long head_offset = 40;
+    const uint32_t corrupt_head = 1000000;
+
+    std::FILE *file = std::fopen(path_.c_str(), "r+b");
+    ASSERT_NE(nullptr, file);
+    std::fseek(file, head_offset, SEEK_SET);
+    std::fwrite(&corrupt_head, sizeof(corrupt_head), 1, file);
+    std::fclose(file);
+
+    EXPECT_THROW(MappedList<int> l(path_), std::runtime_error);
+}
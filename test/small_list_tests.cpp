@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+
+#include "../src/lifetime_helper/lifetime_helper.h"
+#include "list/small_list.h"
+#include <list>
+#include <vector>
+
+namespace
+{
+
+template <class ListType, typename Type>
+bool is_stored_inline(const ListType &l, const Type &value)
+{
+    auto object = reinterpret_cast<const char *>(&l);
+    auto address = reinterpret_cast<const char *>(&value);
+
+    return object <= address && address < object + sizeof(ListType);
+}
+
+template <class ListType>
+std::vector<int> values_of(const ListType &l)
+{
+    return std::vector<int>(l.begin(), l.end());
+}
+
+} // namespace
+
+TEST(SmallListTests, FirstNodesAreStoredInline)
+{
+    SmallList<int, 4> l;
+
+    for (int i = 0; i < 6; ++i)
+        l.push_back(i);
+
+    EXPECT_EQ(6, l.size());
+    EXPECT_EQ(4, l.inline_size());
+
+    for (auto it = l.cbegin(); it != l.cend(); ++it)
+        EXPECT_EQ(*it < 4, is_stored_inline(l, *it));
+
+    l.pop_front();
+    l.push_front(-1);
+
+    EXPECT_EQ(4, l.inline_size());
+    EXPECT_TRUE(is_stored_inline(l, l.front()));
+    EXPECT_EQ((std::vector<int>{-1, 1, 2, 3, 4, 5}), values_of(l));
+
+    l.clear();
+
+    EXPECT_EQ(0, l.inline_size());
+}
+
+TEST(SmallListTests, MoveAndSwapKeepOrderOfInlineAndHeapNodes)
+{
+    SmallList<int, 3> source{1, 2, 3, 4, 5};
+    source.pop_front();
+    source.push_back(6);
+
+    SmallList<int, 3> moved(std::move(source));
+
+    EXPECT_TRUE(source.empty());
+    EXPECT_EQ(0, source.inline_size());
+    EXPECT_EQ((std::vector<int>{2, 3, 4, 5, 6}), values_of(moved));
+
+    for (const int &value : moved)
+        EXPECT_FALSE(is_stored_inline(source, value));
+
+    SmallList<int, 3> other{10, 20};
+
+    moved.swap(other);
+
+    EXPECT_EQ((std::vector<int>{10, 20}), values_of(moved));
+    EXPECT_EQ((std::vector<int>{2, 3, 4, 5, 6}), values_of(other));
+    EXPECT_TRUE(is_stored_inline(moved, moved.front()));
+    EXPECT_TRUE(is_stored_inline(other, other.front()));
+
+    other = std::move(moved);
+
+    EXPECT_TRUE(moved.empty());
+    EXPECT_EQ((std::vector<int>{10, 20}), values_of(other));
+
+    SmallList<int, 3> copy(other);
+    copy = other;
+
+    EXPECT_EQ(values_of(other), values_of(copy));
+    EXPECT_EQ(2, copy.inline_size());
+}
+
+TEST(SmallListTests, SpliceMovesInlineElementsIntoDestination)
+{
+    SmallList<int, 2> source{1, 2, 3, 4, 5};
+    SmallList<int, 2> destination{100, 200};
+
+    destination.splice(std::next(destination.cbegin()), source, std::next(source.cbegin()),
+                       std::next(source.cbegin(), 4));
+
+    EXPECT_EQ((std::vector<int>{1, 5}), values_of(source));
+    EXPECT_EQ((std::vector<int>{100, 2, 3, 4, 200}), values_of(destination));
+
+    destination.splice(destination.cend(), source);
+
+    EXPECT_TRUE(source.empty());
+    EXPECT_EQ(0, source.inline_size());
+    EXPECT_EQ((std::vector<int>{100, 2, 3, 4, 200, 1, 5}), values_of(destination));
+
+    for (const int &value : destination)
+        EXPECT_FALSE(is_stored_inline(source, value));
+
+    destination.splice(destination.cbegin(), destination, std::prev(destination.cend()));
+
+    EXPECT_EQ((std::vector<int>{5, 100, 2, 3, 4, 200, 1}), values_of(destination));
+}
+
+TEST(SmallListTests, SortingAndMergingWorkCorrectly)
+{
+    SmallList<int, 4> l{432, 66, 123, 778, 1, 745, 7};
+    SmallList<int, 4> other{12, 654, 1, 777};
+
+    l.sort();
+    other.sort();
+    l.merge(other);
+
+    std::vector<int> expected{432, 66, 123, 778, 1, 745, 7, 12, 654, 1, 777};
+    std::sort(expected.begin(), expected.end());
+
+    EXPECT_TRUE(other.empty());
+    EXPECT_EQ(expected, values_of(l));
+
+    l.reverse();
+
+    EXPECT_TRUE(std::equal(expected.rbegin(), expected.rend(), l.begin()));
+}
+
+TEST(SmallListTests, ObjectsAreConstructedAndDestructedCorrectly)
+{
+    {
+        SmallList<LifetimeHelper, 3> l;
+
+        for (int i = 0; i < 5; ++i)
+            l.emplace_back();
+
+        SmallList<LifetimeHelper, 3> other(std::move(l));
+        SmallList<LifetimeHelper, 3> copy(other);
+
+        EXPECT_EQ(10, LifetimeHelper::get_alive_count());
+
+        copy.splice(copy.cbegin(), other, other.cbegin());
+        other.swap(copy);
+
+        EXPECT_EQ(10, LifetimeHelper::get_alive_count());
+    }
+
+    EXPECT_EQ(0, LifetimeHelper::get_alive_count());
+}
@@ -0,0 +1,217 @@
+#include <gtest/gtest.h>
+
+#include "../src/lifetime_helper/lifetime_helper.h"
+#include "list/unrolled_list.h"
+#include <list>
+#include <string>
+
+using SmallBlockList = UnrolledList<int, 4>;
+
+TEST(UnrolledListTests, SizeIsChangingCorrectly)
+{
+    SmallBlockList l;
+    ASSERT_TRUE(l.empty());
+
+    for (int i = 1; i <= 10; ++i)
+    {
+        l.push_front(i);
+        l.push_back(i * 2);
+
+        EXPECT_EQ(i * 2, l.size());
+    }
+
+    for (int i = 9; i >= 0; --i)
+    {
+        l.pop_front();
+        l.pop_back();
+        EXPECT_EQ(i * 2, l.size());
+    }
+
+    EXPECT_TRUE(l.empty());
+}
+
+TEST(UnrolledListTests, PushedObjectsArePlacedInRightOrder)
+{
+    SmallBlockList l;
+    std::list<int> reference;
+
+    for (int i = 0; i < 50; ++i)
+    {
+        l.push_front(i);
+        l.push_back(-i);
+        reference.push_front(i);
+        reference.push_back(-i);
+    }
+
+    ASSERT_EQ(reference.size(), l.size());
+    EXPECT_TRUE(std::equal(reference.begin(), reference.end(), l.begin()));
+    EXPECT_TRUE(std::equal(reference.crbegin(), reference.crend(), l.crbegin()));
+}
+
+TEST(UnrolledListTests, InsertAndEraseInTheMiddle)
+{
+    SmallBlockList l;
+    std::list<int> reference;
+
+    for (int i = 0; i < 40; ++i)
+    {
+        auto pos = std::next(l.begin(), l.size() / 2);
+        auto ref_pos = std::next(reference.begin(), reference.size() / 2);
+
+        auto inserted = l.insert(pos, i);
+        reference.insert(ref_pos, i);
+
+        EXPECT_EQ(i, *inserted);
+    }
+
+    ASSERT_TRUE(std::equal(reference.begin(), reference.end(), l.begin()));
+
+    while (l.size() > 3)
+    {
+        auto pos = std::next(l.begin(), l.size() / 3);
+        auto ref_pos = std::next(reference.begin(), reference.size() / 3);
+
+        auto next = l.erase(pos);
+        auto ref_next = reference.erase(ref_pos);
+
+        EXPECT_EQ(*ref_next, *next);
+        ASSERT_EQ(reference.size(), l.size());
+    }
+
+    EXPECT_TRUE(std::equal(reference.begin(), reference.end(), l.begin()));
+}
+
+TEST(UnrolledListTests, InsertingOwnElementIntoFullBlock)
+{
+    UnrolledList<std::string, 4> l;
+
+    for (int i = 0; i < 4; ++i)
+        l.push_back(std::string(32, static_cast<char>('a' + i)));
+
+    auto inserted = l.insert(std::next(l.begin()), l.back());
+
+    EXPECT_EQ(std::string(32, 'd'), *inserted);
+    EXPECT_EQ(std::string(32, 'd'), l.back());
+    EXPECT_EQ(5, l.size());
+}
+
+TEST(UnrolledListTests, ErasingIsNoexceptOnlyForNothrowMoves)
+{
+    struct ThrowingMove
+    {
+        ThrowingMove() = default;
+
+        ThrowingMove(ThrowingMove &&) noexcept(false)
+        {
+        }
+
+        ThrowingMove &operator=(ThrowingMove &&) noexcept(false)
+        {
+            return *this;
+        }
+    };
+
+    UnrolledList<ThrowingMove, 4> throwing;
+    SmallBlockList nothrow;
+
+    EXPECT_FALSE(noexcept(throwing.erase(throwing.cbegin())));
+    EXPECT_FALSE(noexcept(throwing.pop_front()));
+    EXPECT_TRUE(noexcept(nothrow.erase(nothrow.cbegin())));
+    EXPECT_TRUE(noexcept(nothrow.pop_front()));
+}
+
+TEST(UnrolledListTests, SortingWorksCorrectly)
+{
+    SmallBlockList l{432, 66, 123, 778, 1, 745, 7, 1, 6543, 78, 345, 777, 124, 55, 11, 44, 53};
+
+    l.sort();
+
+    EXPECT_EQ(17, l.size());
+    EXPECT_TRUE(std::is_sorted(l.cbegin(), l.cend()));
+}
+
+TEST(UnrolledListTests, SpliceWorksCorrectly)
+{
+    SmallBlockList reference{432, 66, 123, 778, 1, 745, 7, 1, 6543, 78, 345, 777, 124, 55, 11, 44, 53};
+    SmallBlockList source(reference);
+    SmallBlockList destination{1000, 1001, 1002};
+
+    destination.splice(std::next(destination.cbegin()), source);
+
+    ASSERT_TRUE(source.empty());
+    ASSERT_EQ(reference.size() + 3, destination.size());
+    EXPECT_EQ(1000, destination.front());
+    EXPECT_EQ(1002, destination.back());
+    EXPECT_TRUE(std::equal(reference.begin(), reference.end(), std::next(destination.begin())));
+
+    source = reference;
+    destination = {1000, 1001, 1002};
+
+    auto first = std::next(source.cbegin(), 3);
+    auto last = std::next(source.cbegin(), 13);
+
+    destination.splice(std::next(destination.cbegin(), 2), source, first, last);
+
+    EXPECT_EQ(7, source.size());
+    EXPECT_EQ(13, destination.size());
+    EXPECT_TRUE(std::equal(std::next(reference.begin(), 3), std::next(reference.begin(), 13),
+                           std::next(destination.begin(), 2)));
+    EXPECT_EQ(1002, destination.back());
+
+    destination.splice(destination.cbegin(), destination, std::prev(destination.cend()));
+
+    EXPECT_EQ(13, destination.size());
+    EXPECT_EQ(1002, destination.front());
+}
+
+TEST(UnrolledListTests, ReverseWorksCorrectly)
+{
+    SmallBlockList l{432, 66, 123, 778, 1, 745, 7, 1, 6543, 78, 345, 777, 124, 55, 11, 44, 53};
+    SmallBlockList reversed_l{53, 44, 11, 55, 124, 777, 345, 78, 6543, 1, 7, 745, 1, 778, 123, 66, 432};
+
+    l.reverse();
+
+    ASSERT_EQ(l.size(), reversed_l.size());
+    EXPECT_TRUE(std::equal(l.cbegin(), l.cend(), reversed_l.cbegin()));
+    EXPECT_TRUE(std::equal(l.crbegin(), l.crend(), reversed_l.crbegin()));
+}
+
+TEST(UnrolledListTests, MergeWorksCorrectly)
+{
+    SmallBlockList destination{432, 66, 123, 778, 1, 745, 7, 1, 6543, 78, 345, 777, 124, 55, 11, 44, 53};
+    SmallBlockList source{12, 654, 757, 777, 1231, 345, 1, 333, 435, 876, 678, 22, 5, 7434, 234, 23};
+
+    size_t expected_size = destination.size() + source.size();
+
+    destination.sort();
+    source.sort();
+
+    destination.merge(source);
+
+    ASSERT_TRUE(source.empty());
+    ASSERT_EQ(expected_size, destination.size());
+    EXPECT_TRUE(std::is_sorted(destination.begin(), destination.end()));
+}
+
+TEST(UnrolledListTests, ObjectsAreConstructedAndDestructedCorrectly)
+{
+    {
+        UnrolledList<LifetimeHelper, 3> l;
+
+        for (int i = 0; i < 10; ++i)
+            l.emplace_back();
+
+        EXPECT_EQ(10, LifetimeHelper::get_alive_count());
+
+        l.erase(std::next(l.begin(), 4));
+        l.pop_front();
+
+        EXPECT_EQ(8, LifetimeHelper::get_alive_count());
+
+        UnrolledList<LifetimeHelper, 3> copy(l);
+
+        EXPECT_EQ(16, LifetimeHelper::get_alive_count());
+    }
+
+    EXPECT_EQ(0, LifetimeHelper::get_alive_count());
+}